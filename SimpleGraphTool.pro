@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT       += core gui
+QT       += core gui concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -26,10 +26,30 @@ DEFINES += QT_DEPRECATED_WARNINGS
 SOURCES += \
         dvninputdialog.cpp \
         graphics\sources\EdgeGraphicsItem.cpp \
+        graphics\sources\EdgeLayerItem.cpp \
+        graphics\sources\QuadTree.cpp \
+        graphics\sources\TileCache.cpp \
+        graphics\sources\HitIndex.cpp \
         basis\sources\Graph.cpp \
+        basis\sources\CompactGraph.cpp \
+        basis\sources\ForceLayout.cpp \
+        basis\sources\MultilevelLayout.cpp \
+        basis\sources\LayeredLayout.cpp \
+        basis\sources\TreeLayout.cpp \
+        basis\sources\AlgorithmContext.cpp \
+        basis\sources\TaskScheduler.cpp \
+        basis\sources\ParallelBFS.cpp \
+        basis\sources\DeltaStepping.cpp \
+        basis\sources\ContractionHierarchy.cpp \
+        basis\sources\DistanceTable.cpp \
+        basis\sources\NodeSequence.cpp \
+        basis\sources\PlaybackTimeline.cpp \
+        basis\sources\AlgorithmStepper.cpp \
         graphics\sources\GraphGraphicsScene.cpp \
         graphics\sources\GraphGraphicsView.cpp \
         widgets\sources\AdjacencyMatrixTable.cpp \
+        widgets\sources\AdjacencyMatrixModel.cpp \
+        widgets\sources\AdjacencyHeatmap.cpp \
         basis\sources\GraphUtils.cpp \
         widgets\sources\MultiLineInputDialog.cpp \
         main.cpp \
@@ -40,16 +60,41 @@ SOURCES += \
         widgets\sources\GraphPropertiesTable.cpp \
         widgets\sources\GraphOptionDialog.cpp \
         widgets\sources\IncidenceMatrixTable.cpp \
+        widgets\sources\IncidenceMatrixModel.cpp \
         widgets\sources\MultiComboboxDialog.cpp
 
 HEADERS += \
     dvninputdialog.h \
     graphics\headers\EdgeGraphicsItem.h \
+    graphics\headers\EdgeLayerItem.h \
+    graphics\headers\QuadTree.h \
+    graphics\headers\TileCache.h \
+    graphics\headers\HitIndex.h \
+    graphics\headers\QtPoint.h \
     graphics\headers\GraphGraphicsScene.h \
     graphics\headers\GraphGraphicsView.h \
     graphics\headers\NodeGraphicsItem.h \
     widgets\headers\AdjacencyMatrixTable.h \
+    widgets\headers\AdjacencyMatrixModel.h \
+    widgets\headers\AdjacencyHeatmap.h \
     basis\headers\Graph.h \
+    basis\headers\CompactGraph.h \
+    basis\headers\ForceLayout.h \
+    basis\headers\MultilevelLayout.h \
+    basis\headers\LayeredLayout.h \
+    basis\headers\TreeLayout.h \
+    basis\headers\AlgorithmContext.h \
+    basis\headers\ChunkedArray.h \
+    basis\headers\GraphSnapshot.h \
+    basis\headers\TaskScheduler.h \
+    basis\headers\ParallelBFS.h \
+    basis\headers\DeltaStepping.h \
+    basis\headers\ContractionHierarchy.h \
+    basis\headers\DistanceTable.h \
+    basis\headers\NodeSequence.h \
+    basis\headers\PlaybackTimeline.h \
+    basis\headers\AlgorithmStepper.h \
+    basis\headers\LayoutMonitor.h \
     basis\headers\GraphUtils.h \
     widgets\headers\MultiLineInputDialog.h \
     widgets\headers\ElementPropertiesTable.h \
@@ -57,10 +102,15 @@ HEADERS += \
     widgets\headers\GraphOptionDialog.h \
     basis\headers\Edge.h \
     widgets\headers\IncidenceMatrixTable.h \
+    widgets\headers\IncidenceMatrixModel.h \
     basis\headers\Matrix.h \
+    basis\headers\GraphEvent.h \
     utils\random.h \
-    utils\qdebugstream.h \
+    utils\AlgorithmRunner.h \
+    utils\GraphChangeBus.h \
+    utils\LayoutRunner.h \
     basis\headers\Node.h \
+    basis\headers\Point.h \
     widgets\headers\MultiComboboxDialog.h \
     mainwindow.h
 
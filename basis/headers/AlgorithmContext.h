@@ -0,0 +1,88 @@
+#ifndef ALGORITHMCONTEXT_H
+#define ALGORITHMCONTEXT_H
+
+#include <atomic>
+#include <mutex>
+#include <streambuf>
+#include <string>
+
+namespace GraphType {
+
+    // Thrown out of an algorithm whose context was cancelled
+    struct AlgorithmCancelled {
+    };
+
+    /*
+     * Progress, cancellation and console output of the algorithm running on the current thread.
+     * Algorithms call step() in their loops, which costs two relaxed atomics and does nothing
+     * on a thread without a context, so the same code still runs synchronously.
+     */
+    class AlgorithmContext {
+
+    public:
+        // Makes `context` current on this thread for the lifetime of the scope
+        class Scope {
+        public:
+            explicit Scope(AlgorithmContext *context) : _previous(_current) { _current = context; }
+
+            ~Scope() { _current = _previous; }
+
+            Scope(const Scope &) = delete;
+
+            Scope &operator=(const Scope &) = delete;
+
+        private:
+            AlgorithmContext *_previous;
+        };
+
+        // Installed into std::cout, sends what a thread with a context prints to that context
+        class Output : public std::streambuf {
+        public:
+            explicit Output(std::streambuf *fallback) : _fallback(fallback) {}
+
+            std::streambuf *fallback() const { return this->_fallback; }
+
+        protected:
+            int_type overflow(int_type c) override;
+
+            std::streamsize xsputn(const char *s, std::streamsize n) override;
+
+            int sync() override;
+
+        private:
+            std::streambuf *_fallback;
+        };
+
+        static AlgorithmContext *current() { return _current; }
+
+        static void step(long long count = 1) {
+            AlgorithmContext *context = _current;
+            if (context == nullptr)
+                return;
+            context->_steps.fetch_add(count, std::memory_order_relaxed);
+            if (context->_cancelled.load(std::memory_order_relaxed))
+                throw AlgorithmCancelled();
+        }
+
+        void cancel() { _cancelled.store(true); }
+
+        bool cancelled() const { return _cancelled.load(); }
+
+        long long steps() const { return _steps.load(std::memory_order_relaxed); }
+
+        void write(const char *s, std::size_t n);
+
+        // Returns what was printed since the last call
+        std::string takeOutput();
+
+    private:
+        std::atomic<bool> _cancelled{false};
+        std::atomic<long long> _steps{0};
+        std::mutex _mutex;
+        std::string _output;
+
+        static thread_local AlgorithmContext *_current;
+    };
+}
+
+#endif // ALGORITHMCONTEXT_H
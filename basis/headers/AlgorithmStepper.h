@@ -0,0 +1,96 @@
+#ifndef ALGORITHMSTEPPER_H
+#define ALGORITHMSTEPPER_H
+
+#include "CompactGraph.h"
+#include "NodeSequence.h"
+#include <functional>
+#include <queue>
+#include <string>
+#include <vector>
+
+namespace GraphType {
+
+    /*
+     * An algorithm that runs one step per call, keeping its frontier between calls, so a
+     * run on a huge graph can be shown while it goes and dropped at any point. Works on
+     * compact arrays made from a snapshot of the graph, without copying the graph itself;
+     * only the state of the run is kept, not the steps.
+     */
+    class AlgorithmStepper {
+
+    public:
+        // The node a run reaches and where from, from is -1 for the source
+        struct Step {
+            NodeId from;
+            NodeId to;
+        };
+
+        virtual ~AlgorithmStepper() = default;
+
+        const NodeNames &names() const { return this->_names; }
+
+        // At most this many steps
+        int countNodes() const { return _compact.countNodes(); }
+
+        // False once the run is over
+        virtual bool next(Step &step) = 0;
+
+    protected:
+        AlgorithmStepper(const Graph *graph, const std::string &source);
+
+        NodeNames _names;
+        CompactGraph _compact;
+        // -1 if there is no such node
+        int _source;
+        std::vector<int> _parent;
+
+        Step step(int v) const;
+    };
+
+    // Same order as GraphUtils::BFSToDemo
+    class BFSStepper : public AlgorithmStepper {
+
+    public:
+        BFSStepper(const Graph *graph, const std::string &source);
+
+        bool next(Step &step) override;
+
+    private:
+        std::vector<int> _targets;
+        std::vector<bool> _visited;
+        std::queue<int> _queue;
+    };
+
+    class DFSStepper : public AlgorithmStepper {
+
+    public:
+        DFSStepper(const Graph *graph, const std::string &source);
+
+        bool next(Step &step) override;
+
+    private:
+        std::vector<int> _targets;
+        std::vector<bool> _visited;
+        std::vector<int> _stack;
+    };
+
+    // Settles nodes by their distance from the source, every step is an edge of the shortest path tree;
+    // with `spanning` nodes are taken by the weight of the edge that reaches them instead, as Prim does
+    class DijkstraStepper : public AlgorithmStepper {
+
+    public:
+        DijkstraStepper(const Graph *graph, const std::string &source, bool spanning = false);
+
+        bool next(Step &step) override;
+
+    private:
+        typedef std::pair<long long, int> Item;
+
+        bool _spanning;
+        std::vector<long long> _key;
+        std::vector<bool> _settled;
+        std::priority_queue<Item, std::vector<Item>, std::greater<Item>> _queue;
+    };
+}
+
+#endif // ALGORITHMSTEPPER_H
@@ -0,0 +1,71 @@
+#ifndef CHUNKEDARRAY_H
+#define CHUNKEDARRAY_H
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace GraphType {
+
+    /*
+     * Array split into fixed chunks that copies share until one of them writes.
+     * A copy costs one reference count, the first write after it copies the chunk
+     * directory and the chunk written to, every other chunk stays shared.
+     * Copies may be read on other threads while the original keeps writing.
+     */
+    template<typename T, int ChunkBits = 8>
+    class ChunkedArray {
+
+    public:
+        static const int ChunkSize = 1 << ChunkBits;
+
+        int size() const { return this->_size; }
+
+        const T &operator[](int i) const { return (*(*_chunks)[i >> ChunkBits])[i & (ChunkSize - 1)]; }
+
+        T &mutableAt(int i) {
+            auto &chunk = (*mutableChunks())[i >> ChunkBits];
+            if (!unique(chunk))
+                chunk = std::make_shared<Chunk>(*chunk);
+            return (*chunk)[i & (ChunkSize - 1)];
+        }
+
+        void push_back(const T &value) {
+            auto chunks = mutableChunks();
+            if (_size == static_cast<int>(chunks->size()) * ChunkSize)
+                chunks->push_back(std::make_shared<Chunk>());
+            ++_size;
+            mutableAt(_size - 1) = value;
+        }
+
+        void clear() {
+            this->_chunks = std::make_shared<Directory>();
+            this->_size = 0;
+        }
+
+    private:
+        typedef std::array<T, ChunkSize> Chunk;
+        typedef std::vector<std::shared_ptr<Chunk>> Directory;
+
+        std::shared_ptr<Directory> _chunks = std::make_shared<Directory>();
+        int _size = 0;
+
+        // A count of one means no copy can see the block, the fence orders their last reads before our writes
+        template<typename Block>
+        static bool unique(const std::shared_ptr<Block> &block) {
+            if (block.use_count() != 1)
+                return false;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return true;
+        }
+
+        Directory *mutableChunks() {
+            if (!unique(_chunks))
+                this->_chunks = std::make_shared<Directory>(*_chunks);
+            return _chunks.get();
+        }
+    };
+}
+
+#endif // CHUNKEDARRAY_H
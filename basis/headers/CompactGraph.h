@@ -0,0 +1,77 @@
+#ifndef COMPACTGRAPH_H
+#define COMPACTGRAPH_H
+
+#include "Graph.h"
+#include <unordered_map>
+#include <vector>
+
+namespace GraphType {
+
+    /*
+     * Read-only copy of the structure of a graph with nodes numbered 0..n-1
+     * and the arcs of every node stored contiguously (compressed sparse rows).
+     * Whole-graph algorithms and layouts sweep these arrays instead of hashing
+     * node pointers on every step.
+     */
+    class CompactGraph {
+
+    private:
+        std::vector<Node *> _nodes;
+        std::unordered_map<const Node *, int> _ids;
+        std::vector<int> _offsets;
+        std::vector<int> _targets;
+        std::vector<int> _weights;
+        std::vector<int> _snapshotIds;
+        std::vector<int> _fromSnapshot;
+        bool _symmetric = false;
+
+    public:
+        // With `symmetric` every edge is reachable from both ends, otherwise directed edges only from their tail
+        explicit CompactGraph(const Graph &graph, bool symmetric = false);
+
+        // Nodes numbered in the order of snapshot.nodeIds() and known by snapshotId() instead of node(),
+        // undirected edges are reachable from both ends; nothing is looked up by name or pointer
+        explicit CompactGraph(const GraphSnapshot &snapshot);
+
+        // A graph made of ids only, e.g. a coarsened level of another one; node() is not available
+        CompactGraph(std::vector<int> offsets, std::vector<int> targets, std::vector<int> weights);
+
+        int countNodes() const { return static_cast<int>(_offsets.size()) - 1; }
+
+        int countArcs() const { return static_cast<int>(_targets.size()); }
+
+        // Every arc has its reverse, so the arcs of a node are its incoming ones as well
+        bool isSymmetric() const { return this->_symmetric; }
+
+        // Ids only, every arc turned around, so the arcs of a node are the ones entering it here
+        CompactGraph reversed() const;
+
+        Node *node(int id) const { return this->_nodes[id]; }
+
+        const std::vector<Node *> &nodes() const { return this->_nodes; }
+
+        // -1 for a node that is not part of the graph
+        int id(const Node *node) const;
+
+        // Only for a graph made from a snapshot
+        int snapshotId(int id) const { return this->_snapshotIds[id]; }
+
+        // The id of a node known by its snapshot id, -1 for none
+        int fromSnapshotId(int id) const;
+
+        int arcBegin(int id) const { return this->_offsets[id]; }
+
+        int arcEnd(int id) const { return this->_offsets[id + 1]; }
+
+        int degree(int id) const { return _offsets[id + 1] - _offsets[id]; }
+
+        int target(int arc) const { return this->_targets[arc]; }
+
+        int weight(int arc) const { return this->_weights[arc]; }
+
+        // Arc targets with the ones of every node sorted, which is the order of graph.nodeList() ids follow
+        std::vector<int> sortedTargets() const;
+    };
+}
+
+#endif // COMPACTGRAPH_H
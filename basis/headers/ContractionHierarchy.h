@@ -0,0 +1,78 @@
+#ifndef CONTRACTIONHIERARCHY_H
+#define CONTRACTIONHIERARCHY_H
+
+#include "CompactGraph.h"
+#include <climits>
+#include <unordered_map>
+#include <vector>
+
+namespace GraphType {
+
+    /*
+     * Contraction hierarchy (Geisberger et al.) for many-to-many distance tables.
+     * Nodes are contracted cheapest first by edge difference, shortcuts keep the
+     * distances of the remaining graph, and a search only climbs to higher ranks.
+     * Contraction stops where nodes get too well connected, as in dense or random
+     * graphs; the rest stays a core that searches cross like a plain graph.
+     * Tables use the bucket method of Knopp et al.: one backward search per target
+     * leaves its distances in buckets, one forward search per source scans them.
+     */
+    class ContractionHierarchy {
+
+    public:
+        static const long long unreachable = LLONG_MAX;
+
+        struct Options {
+            // The core starts once the next node would join more in and out neighbour pairs than this
+            int maxDegreeProduct = 1000;
+            // ... or once the nodes left have more arcs leaving them than this on average
+            int maxMeanDegree = 16;
+            // A witness search settling more nodes gives up and the shortcut is added anyway
+            int witnessSettled = 100;
+        };
+
+        ContractionHierarchy(const CompactGraph &graph, const Options &options);
+
+        int countShortcuts() const { return this->_shortcuts; }
+
+        int coreSize() const { return this->_coreSize; }
+
+        // distances[i * targets.size() + j] from sources[i] to targets[j], node paths in the same layout if asked for
+        void manyToMany(const std::vector<int> &sources, const std::vector<int> &targets,
+                        std::vector<long long> &distances, std::vector<std::vector<int>> *paths = nullptr) const;
+
+    private:
+        // middle is the contracted node a shortcut bypasses, -1 for an arc of the graph
+        struct Arc {
+            int node;
+            int middle;
+            long long weight;
+        };
+
+        struct Label {
+            long long distance;
+            int parent;
+            int middle;
+        };
+
+        // The state of one search; labels are indexed by node and only the touched ones are reset
+        struct Space {
+            std::vector<Label> labels;
+            std::vector<int> touched;
+            std::vector<std::pair<int, long long>> settled;
+        };
+
+        // Arcs to higher ranks (and within the core) leaving a node, and entering it
+        std::vector<std::vector<Arc>> _up, _down;
+        int _shortcuts = 0;
+        int _coreSize = 0;
+
+        // Dijkstra on the upward arcs, or on the downward ones backwards; settled in order of distance
+        void search(int origin, bool forward, Space &space) const;
+
+        // Appends the nodes after `from` on the arc from -> to, shortcuts expanded
+        void unpack(int from, int to, int middle, std::vector<int> &path) const;
+    };
+}
+
+#endif // CONTRACTIONHIERARCHY_H
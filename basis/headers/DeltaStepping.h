@@ -0,0 +1,51 @@
+#ifndef DELTASTEPPING_H
+#define DELTASTEPPING_H
+
+#include "CompactGraph.h"
+#include <atomic>
+#include <climits>
+#include <vector>
+
+namespace GraphType {
+
+    /*
+     * Single source shortest paths by delta-stepping (Meyer, Sanders). Nodes wait in
+     * buckets of width delta by tentative distance; the lowest bucket relaxes its light
+     * arcs (weight <= delta) round after round until it stays empty, then the heavy arcs
+     * of everything it settled once. Every round is split across the TaskScheduler and
+     * distances are lowered with an atomic compare-exchange.
+     */
+    class DeltaStepping {
+
+    public:
+        static const long long unreachable = LLONG_MAX;
+
+        struct Options {
+            // Bucket width, 0 derives it from the mean weight and degree
+            long long delta = 0;
+        };
+
+        DeltaStepping(const CompactGraph &graph, const Options &options);
+
+        long long delta() const { return this->_delta; }
+
+        // distance is `unreachable` and parent -1 for nodes not reached, the source is its own parent
+        void run(int source, std::vector<long long> &distance, std::vector<int> &parent);
+
+        // Light rounds of the last run, a measure of its parallel depth
+        int countRounds() const { return this->_rounds; }
+
+    private:
+        const CompactGraph &_graph;
+        long long _delta;
+        std::vector<std::atomic<long long>> _distance;
+        // Last round and last bucket a node was expanded in, so duplicate queue entries are skipped
+        std::vector<std::atomic<long long>> _lightMark, _heavyMark;
+        int _rounds = 0;
+
+        // Relaxes the light or heavy arcs of the nodes, returns (bucket, node) for every distance lowered
+        std::vector<std::pair<long long, int>> relax(const std::vector<int> &nodes, bool light);
+    };
+}
+
+#endif // DELTASTEPPING_H
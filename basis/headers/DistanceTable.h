@@ -0,0 +1,56 @@
+#ifndef DISTANCETABLE_H
+#define DISTANCETABLE_H
+
+#include "CompactGraph.h"
+#include "ContractionHierarchy.h"
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace GraphType {
+
+    /*
+     * Dense tables of shortest distances between a list of sources and a list of targets.
+     * Shallow unweighted graphs run bit-parallel BFS, 64 sources sharing every sweep over the arcs.
+     * Otherwise the ContractionHierarchy is built on the first table and kept for the next
+     * ones; if its core is too large for buckets to pay off, every source runs Dijkstra.
+     * Sources, or targets, are spread over the TaskScheduler.
+     */
+    class DistanceTable {
+
+    public:
+        static const long long unreachable = LLONG_MAX;
+
+        struct Options {
+            ContractionHierarchy::Options hierarchy;
+        };
+
+        DistanceTable(const CompactGraph &graph, const Options &options);
+
+        ~DistanceTable();
+
+        // distances[i * targets.size() + j] from sources[i] to targets[j], node paths in the same layout if asked for
+        void compute(const std::vector<int> &sources, const std::vector<int> &targets,
+                     std::vector<long long> &distances, std::vector<std::vector<int>> *paths = nullptr);
+
+    private:
+        typedef std::uint64_t Word;
+
+        const CompactGraph &_graph;
+        Options _options;
+        bool _unweighted = true;
+        std::unique_ptr<ContractionHierarchy> _hierarchy;
+
+        void bitParallel(const std::vector<int> &sources, const std::vector<int> &targets,
+                         std::vector<long long> &distances) const;
+
+        // Returns the number of levels
+        int breadthFirst(int source, std::vector<int> &depth) const;
+
+        void dijkstra(const std::vector<int> &sources, const std::vector<int> &targets,
+                      std::vector<long long> &distances, std::vector<std::vector<int>> *paths) const;
+    };
+}
+
+#endif // DISTANCETABLE_H
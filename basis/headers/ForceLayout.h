@@ -0,0 +1,76 @@
+#ifndef FORCELAYOUT_H
+#define FORCELAYOUT_H
+
+#include "CompactGraph.h"
+#include <vector>
+
+namespace GraphType {
+
+    /*
+     * Fruchterman-Reingold layout on flat coordinate arrays.
+     * Repulsion between all pairs is approximated with a Barnes-Hut quadtree
+     * rebuilt every iteration, both force passes are split across the TaskScheduler.
+     */
+    class ForceLayout {
+
+    public:
+        struct Options {
+            double idealLength = 200;
+            // Cells narrower than theta times their distance act as a single body
+            double theta = 1.2;
+            double gravity = 0.05;
+            int iterations = 300;
+            // Largest move in the first iteration, 0 picks one from the graph size for a layout from scratch
+            double temperature = 0;
+        };
+
+        ForceLayout(const CompactGraph &graph, std::vector<double> x, std::vector<double> y,
+                    const Options &options);
+
+        // Returns false once the layout has cooled down or converged
+        bool step();
+
+        int iteration() const { return this->_iteration; }
+
+        const Options &options() const { return this->_options; }
+
+        const std::vector<double> &x() const { return this->_x; }
+
+        const std::vector<double> &y() const { return this->_y; }
+
+        // Rescales positions to the area the layout settles in, a spiral if they all coincide
+        static void fit(std::vector<double> &x, std::vector<double> &y, double idealLength);
+
+    private:
+        struct Cell {
+            double cx, cy, half;
+            double mass = 0, mx = 0, my = 0;
+            int child = -1;
+            int body = -1;
+
+            Cell(double x, double y, double h) : cx(x), cy(y), half(h) {}
+        };
+
+        const CompactGraph &_graph;
+        Options _options;
+        std::vector<double> _x, _y, _dx, _dy;
+        std::vector<Cell> _cells;
+        std::vector<int> _next;
+        std::vector<int> _order;
+        double _temperature;
+        double _cooling;
+        int _iteration = 0;
+
+        static constexpr int _maxDepth = 24;
+
+        void buildTree();
+
+        void insert(int body);
+
+        void collectOrder();
+
+        void repulse(int body);
+    };
+}
+
+#endif // FORCELAYOUT_H
@@ -4,6 +4,8 @@
 #include "Node.h"
 #include "Edge.h"
 #include "Matrix.h"
+#include "GraphEvent.h"
+#include "GraphSnapshot.h"
 #include <utility>
 #include <vector>
 #include <list>
@@ -13,6 +15,7 @@
 #include <fstream>
 #include <memory>
 #include <unordered_map>
+#include <functional>
 
 namespace GraphType {
 
@@ -26,6 +29,15 @@ namespace GraphType {
         const bool _weighted;
         const int _invalidValue;
         const std::pair<int, int> _weightRange;
+        unsigned long _version = 0;
+        std::vector<GraphEvent> _events;
+        std::function<void()> _changeHandler;
+        // Tables kept in step with the graph, snapshot() hands out shared copies
+        GraphSnapshot _tables;
+        std::unordered_map<NodePair, int> _edgeIds;
+        std::vector<int> _freeNodeIds;
+        unsigned long _nodesAdded = 0;
+        std::vector<int> _freeEdgeIds;
 
         static int _calcInvalid(bool directed, bool weighted) {
             return directed ? (weighted ? INT_MAX : 0) : 0;
@@ -39,6 +51,18 @@ namespace GraphType {
 
         void _init(int node_num);
 
+        void _record(GraphEvent::Type type, const std::string &u = "", const std::string &v = "", int w = 0);
+
+        void _storeNode(Node *node);
+
+        void _dropNode(Node *node);
+
+        void _storeEdge(const NodePair &pair, int w);
+
+        void _dropEdge(const NodePair &pair);
+
+        void _clearTables(bool nodes);
+
     public:
         explicit Graph(bool directed, bool weighted) :
                 _directed(directed),
@@ -50,6 +74,9 @@ namespace GraphType {
 
         Graph(const Graph &obj);
 
+        // Builds a graph of its own from a snapshot, nodes in the order of their ids
+        explicit Graph(const GraphSnapshot &snapshot);
+
         bool isWeighted() const { return this->_weighted; }
 
         bool isUnweighted() const { return !(this->_weighted); }
@@ -64,10 +91,25 @@ namespace GraphType {
 
         void clear();
 
+        unsigned long version() const { return this->_version; }
+
+        // O(1), the snapshot does not change when the graph does afterwards
+        GraphSnapshot snapshot() const;
+
+        void setChangeHandler(std::function<void()> handler);
+
+        std::vector<GraphEvent> takeEvents();
+
         static Graph readFromFile(const std::string &file);
 
+        // One edge per line, "u v" or "u v weight", lines starting with # or % left out;
+        // the graph is weighted if any edge has a weight
+        static Graph readEdgeList(const std::string &file, bool directed);
+
         static void writeToFile(const std::string &file, const Graph &graph);
 
+        static void writeToFile(const std::string &file, const GraphSnapshot &snapshot);
+
         AdjacencyMatrix adjMatrix() const {
             return AdjacencyMatrix(_cachedNodeList, _edgeSet, _directed, _invalidValue);
         }
@@ -106,6 +148,9 @@ namespace GraphType {
 
         bool setNodeName(const std::string &old_name, const std::string &new_name);
 
+        // Moving a node is not a structural change, the version stays the same
+        bool setNodePos(Node *node, const Point &pos);
+
         inline int countEdges() const { return this->_edgeSet.size(); }
 
         Edge edge(Node *u, Node *v) const;
@@ -136,7 +181,7 @@ namespace GraphType {
 
         int weight(const std::string &uname, const std::string &vname) const;
 
-        void clearEdges() { this->_edgeSet.clear(); }
+        void clearEdges();
 
         Graph transpose() const;
 
@@ -0,0 +1,25 @@
+#ifndef GRAPHEVENT_H
+#define GRAPHEVENT_H
+
+#include <string>
+
+namespace GraphType {
+
+    /*
+     * A single structural change of a Graph. Events are journaled by the graph
+     * in the order they happen and stamped with the graph version after the change.
+     */
+    struct GraphEvent {
+        enum Type {
+            NodeAdded, NodeRemoved, EdgeSet, EdgeRemoved, Cleared
+        };
+
+        Type type;
+        std::string u;
+        std::string v;
+        int weight;
+        unsigned long version;
+    };
+}
+
+#endif // GRAPHEVENT_H
@@ -0,0 +1,85 @@
+#ifndef GRAPHSNAPSHOT_H
+#define GRAPHSNAPSHOT_H
+
+#include "ChunkedArray.h"
+#include "Point.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace GraphType {
+
+    class Graph;
+
+    struct NodeRecord {
+        std::string name;
+        Point pos;
+        bool alive = false;
+        // Nodes added later have larger numbers, whatever id they reuse
+        unsigned long sequence = 0;
+    };
+
+    // An undirected edge keeps the orientation it was first set in
+    struct EdgeRecord {
+        int u = -1;
+        int v = -1;
+        int weight = 0;
+
+        bool alive() const { return u >= 0; }
+    };
+
+    /*
+     * Read-only version of a graph that shares its node and edge tables with the graph
+     * it was taken from. Taking one is O(1) and it stays valid and unchanged while the
+     * graph goes on being edited, so it can be read on another thread without locks.
+     * Nodes and edges are addressed by ids that last as long as they do; freed ids
+     * are reused, so ids are compared within one snapshot only.
+     */
+    class GraphSnapshot {
+
+    public:
+        GraphSnapshot() = default;
+
+        bool isDirected() const { return this->_directed; }
+
+        bool isWeighted() const { return this->_weighted; }
+
+        unsigned long version() const { return this->_version; }
+
+        int countNodes() const { return this->_countNodes; }
+
+        int countEdges() const { return this->_countEdges; }
+
+        // Ids are below the capacity, with gaps where nodes or edges were removed
+        int nodeCapacity() const { return _nodes.size(); }
+
+        int edgeCapacity() const { return _edges.size(); }
+
+        bool hasNode(int id) const { return id >= 0 && id < _nodes.size() && _nodes[id].alive; }
+
+        const NodeRecord &node(int id) const { return this->_nodes[id]; }
+
+        // Ids of the nodes in the order they were added, the order of Graph::nodeList
+        std::vector<int> nodeIds() const;
+
+        bool hasEdge(int id) const { return id >= 0 && id < _edges.size() && _edges[id].alive(); }
+
+        const EdgeRecord &edge(int id) const { return this->_edges[id]; }
+
+        // Same format as Graph::writeToFile
+        friend std::ostream &operator<<(std::ostream &os, const GraphSnapshot &snapshot);
+
+    private:
+        ChunkedArray<NodeRecord> _nodes;
+        ChunkedArray<EdgeRecord> _edges;
+        bool _directed = false;
+        bool _weighted = false;
+        unsigned long _version = 0;
+        int _countNodes = 0;
+        int _countEdges = 0;
+
+        friend class Graph;
+    };
+}
+
+#endif // GRAPHSNAPSHOT_H
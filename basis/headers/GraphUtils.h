@@ -2,9 +2,11 @@
 #define GRAPH_UTILS_H
 
 #include "Graph.h"
+#include "NodeSequence.h"
 #include <queue>
 #include <stack>
 #include <list>
+#include <vector>
 
 using namespace GraphType;
 
@@ -18,21 +20,39 @@ private:
 
 public:
 
-    static std::list<std::string> BFS(const Graph *graph, std::string source = "");
+    static NodeSequence BFS(const Graph *graph, std::string source = "");
 
-    static std::list<std::string> DFS(const Graph *graph, std::string source = "");
+    static NodeSequence DFS(const Graph *graph, std::string source = "");
 
-    static std::list<std::pair<std::string, std::string>> BFSToDemo(const Graph *graph, const std::string &source);
+    static NodePairSequence BFSToDemo(const Graph *graph, const std::string &source);
 
-    static std::list<std::pair<std::string, std::string>> DFSToDemo(const Graph *graph, const std::string &source);
+    // The traversals read a snapshot straight away, background jobs need no copy of the graph for them
+    static NodePairSequence BFSToDemo(const GraphSnapshot &graph, const std::string &source);
+
+    static NodePairSequence DFSToDemo(const Graph *graph, const std::string &source);
+
+    static NodePairSequence DFSToDemo(const GraphSnapshot &graph, const std::string &source);
+
+    // Breadth-first tree as (parent, child) pairs level by level, searched by ParallelBFS on compact adjacency
+    static NodePairSequence BFSTree(const Graph *graph, const std::string &source);
+
+    static NodePairSequence BFSTree(const GraphSnapshot &graph, const std::string &source);
 
     static std::list<std::string> Dijkstra(const Graph *graph, const std::string &start, const std::string &goal);
 
-    static std::list<std::pair<std::string, std::string>> spanningTreeDFS(const Graph *graph, const std::string &source);
+    // Same answer as Dijkstra, searched by the parallel DeltaStepping kernel on compact adjacency
+    static std::list<std::string> DeltaSteppingPath(const Graph *graph, const std::string &start, const std::string &goal);
+
+    // Distances from every source to every target row by row, DistanceTable::unreachable without a path;
+    // small tables are printed, with the paths when they are smaller still
+    static std::vector<long long> distanceTable(const Graph *graph, const std::vector<std::string> &sources,
+                                                const std::vector<std::string> &targets);
+
+    static NodePairSequence spanningTreeDFS(const Graph *graph, const std::string &source);
 
-    static std::list<std::pair<std::string, std::string>> spanningTreeBFS(const Graph *graph, const std::string &source);
+    static NodePairSequence spanningTreeBFS(const Graph *graph, const std::string &source);
 
-    static std::list<std::pair<std::string, std::string>> Prim(const Graph *graph, std::string source = "");
+    static NodePairSequence Prim(const Graph *graph, std::string source = "");
 
     static std::list<std::list<std::string>> connectedComponents(const Graph *graph);
 
@@ -60,7 +80,7 @@ public:
 
     static std::list<std::list<std::string>> displayAllHamiltonianCircuits(const Graph *graph);
 
-    static std::list<std::list<std::string>> displayAllEulerianCircuits(const Graph *graph);
+    static NodeGroups displayAllEulerianCircuits(const Graph *graph);
 
     static std::list<std::string> getTopoSortResult(const Graph *graph);
 
@@ -68,7 +88,8 @@ public:
 
     static std::list<std::pair<std::string, int>> getColoringResult(const Graph *graph, std::string source = "");
 
-    static std::list<std::pair<std::string, std::string>> displayColoring(const Graph *graph, std::string source = "");
+    // One group per colour
+    static NodeGroups displayColoring(const Graph *graph, std::string source = "");
 
     static bool isCycle(const Graph *graph);
 
@@ -80,9 +101,9 @@ public:
 
     static std::list<std::list<std::string>> Gotlieb(const Graph *graph);
 
-    static QString isFull(const Graph *graph);
+    static std::string isFull(const Graph *graph);
 
-    static QString SummaryOfAllNodesDegrees(const Graph *graph);
+    static std::string SummaryOfAllNodesDegrees(const Graph *graph);
 
     static void DFSRadix(const Graph *graph, const std::string &vname, std::unordered_map<std::string, bool> &visited,
                                      std::list<std::string> &vertexes, int radix);
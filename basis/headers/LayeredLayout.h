@@ -0,0 +1,77 @@
+#ifndef LAYEREDLAYOUT_H
+#define LAYEREDLAYOUT_H
+
+#include "CompactGraph.h"
+#include "LayoutMonitor.h"
+#include <unordered_set>
+#include <vector>
+
+namespace GraphType {
+
+    /*
+     * Hierarchical (Sugiyama) layout of a directed graph, edges pointing downwards.
+     * Cycles are broken with the Eades-Lin-Smyth feedback arc heuristic, layers come
+     * from longest paths shortened locally, long edges are split by dummy nodes,
+     * crossings are reduced by barycenter sweeps counted with the Barth-Juenger-Mutzel
+     * accumulator tree, and x coordinates are assigned by Brandes-Koepf.
+     */
+    class LayeredLayout {
+
+    public:
+        struct Options {
+            // Distances between centers of neighbouring nodes and layers
+            double nodeSpacing = 80;
+            double layerSpacing = 120;
+            // Width reserved for an edge passing through a layer
+            double dummySpacing = 30;
+            int sweeps = 24;
+        };
+
+        // The graph has to be built without `symmetric`, otherwise every edge is a cycle
+        LayeredLayout(const CompactGraph &graph, const Options &options);
+
+        // Returns false when the monitor cancelled the layout, x and y are then left untouched
+        bool run(std::vector<double> &x, std::vector<double> &y, LayoutMonitor &monitor);
+
+        // Nodes inserted where edges pass through a layer, valid after run()
+        int countDummies() const { return static_cast<int>(_layer.size()) - _graph.countNodes(); }
+
+        int countLayers() const { return static_cast<int>(this->_layers.size()); }
+
+        // Crossings of the chosen order, valid after run()
+        long long crossings() const { return this->_crossings; }
+
+    private:
+        const CompactGraph &_graph;
+        Options _options;
+        // Real nodes keep their ids, dummies are numbered after them
+        std::vector<int> _layer;
+        std::vector<std::vector<int>> _layers;
+        std::vector<std::vector<int>> _up, _down;
+        std::vector<int> _pos;
+        long long _crossings = 0;
+
+        bool isDummy(int v) const { return v >= _graph.countNodes(); }
+
+        std::vector<std::vector<int>> acyclicArcs() const;
+
+        void assignLayers(const std::vector<std::vector<int>> &arcs);
+
+        void insertDummies(const std::vector<std::vector<int>> &arcs);
+
+        void initialOrder();
+
+        void sweep(bool downwards);
+
+        long long countCrossings() const;
+
+        // Segments crossing an inner segment between two dummies, keyed upper * count + lower
+        std::unordered_set<long long> markConflicts() const;
+
+        std::vector<double> place(bool upwards, bool rightwards, const std::unordered_set<long long> &conflicts) const;
+
+        double separation(int u, int v) const;
+    };
+}
+
+#endif // LAYEREDLAYOUT_H
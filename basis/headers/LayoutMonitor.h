@@ -0,0 +1,25 @@
+#ifndef LAYOUTMONITOR_H
+#define LAYOUTMONITOR_H
+
+#include <vector>
+
+namespace GraphType {
+
+    // Lets a long running layout report progress and intermediate positions and notice a cancellation
+    class LayoutMonitor {
+
+    public:
+        virtual ~LayoutMonitor() = default;
+
+        virtual bool cancelled() const { return false; }
+
+        virtual void progress(int /*percent*/) {}
+
+        // Layouts that have to assemble a frame first ask before doing so
+        virtual bool wantsFrame() const { return false; }
+
+        virtual void frame(const std::vector<double> &/*x*/, const std::vector<double> &/*y*/) {}
+    };
+}
+
+#endif // LAYOUTMONITOR_H
@@ -6,7 +6,7 @@
 #include <climits>
 #include "Node.h"
 #include "Edge.h"
-#include <QDebug>
+#include <algorithm>
 #include <queue>
 
 namespace GraphType {
@@ -0,0 +1,52 @@
+#ifndef MULTILEVELLAYOUT_H
+#define MULTILEVELLAYOUT_H
+
+#include "CompactGraph.h"
+#include "ForceLayout.h"
+#include "LayoutMonitor.h"
+#include <vector>
+
+namespace GraphType {
+
+    /*
+     * Multilevel force-directed layout for graphs too large to untangle from scratch.
+     * The graph is repeatedly coarsened by heavy edge matching, the coarsest level is
+     * laid out completely, then every finer level starts from the positions of the
+     * level above and only needs a short, cool refinement.
+     */
+    class MultilevelLayout {
+
+    public:
+        struct Options {
+            // Ideal length, theta and gravity are taken from here, iterations apply to the coarsest level
+            ForceLayout::Options force;
+            int coarsestSize = 64;
+            int refineIterations = 60;
+            int maxLevels = 40;
+        };
+
+        MultilevelLayout(const CompactGraph &graph, const Options &options);
+
+        // Including the graph itself
+        int countLevels() const { return static_cast<int>(_levels.size()) + 1; }
+
+        // Returns false when the monitor cancelled the layout, x and y then hold the last full frame
+        bool run(std::vector<double> &x, std::vector<double> &y, LayoutMonitor &monitor);
+
+    private:
+        const CompactGraph &_graph;
+        Options _options;
+        // _levels[l] is level l + 1, _parents[l][v] is the node of level l + 1 that v of level l was merged into
+        std::vector<CompactGraph> _levels;
+        std::vector<std::vector<int>> _parents;
+
+        const CompactGraph &level(int l) const { return l == 0 ? _graph : _levels[l - 1]; }
+
+        bool coarsen(const CompactGraph &graph);
+
+        // Maps every node of the graph to its ancestor on level l
+        std::vector<int> ancestors(int l) const;
+    };
+}
+
+#endif // MULTILEVELLAYOUT_H
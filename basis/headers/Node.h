@@ -3,7 +3,7 @@
 
 #include <iostream>
 #include <utility>
-#include <QPointF>
+#include "Point.h"
 
 namespace GraphType {
     class Node {
@@ -12,8 +12,10 @@ namespace GraphType {
         int _degPos;
         int _degNeg;
         int _deg;
+        // Index in the graph's snapshot tables
+        int _id = -1;
         std::string _name;
-        QPointF _euclidePos;
+        Point _euclidePos;
 
         void incPosDegree() { this->_degPos++; }
 
@@ -27,8 +29,12 @@ namespace GraphType {
 
         void decUndirDegree() { if (this->_deg > 0) this->_deg--; }
 
+        void resetDegree() { this->_degPos = this->_degNeg = this->_deg = 0; }
+
         void setName(std::string newName) { this->_name = std::move(newName); }
 
+        void setEuclidePos(const Point &pos) { this->_euclidePos = pos; }
+
         friend class Graph;
 
         Node() {
@@ -39,7 +45,7 @@ namespace GraphType {
 
         explicit Node(std::string name);
 
-        explicit Node(std::string name, QPointF);
+        explicit Node(std::string name, Point);
 
         int negDegree() const { return this->_degNeg; }
 
@@ -49,9 +55,9 @@ namespace GraphType {
 
         int dirDegree() const { return this->_degPos + this->_degNeg; }
 
-        QPointF euclidePos() const { return this->_euclidePos; }
+        Point euclidePos() const { return this->_euclidePos; }
 
-        void setEuclidePos(const QPointF &pos) { this->_euclidePos = pos; }
+        int id() const { return this->_id; }
 
         std::string name() const { return this->_name; }
 
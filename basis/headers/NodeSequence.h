@@ -0,0 +1,137 @@
+#ifndef NODESEQUENCE_H
+#define NODESEQUENCE_H
+
+#include "Graph.h"
+#include <list>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace GraphType {
+
+    typedef int NodeId;
+
+    /*
+     * Algorithm results as contiguous node ids of the graph they were computed on.
+     * A snapshot of that graph comes along, so names are looked up only when they
+     * are shown and without copies, and stay right after the graph itself is gone.
+     */
+    class NodeNames {
+
+    public:
+        NodeNames() = default;
+
+        explicit NodeNames(const Graph *graph) : _graph(graph->snapshot()) {}
+
+        explicit NodeNames(const GraphSnapshot &graph) : _graph(graph) {}
+
+        const GraphSnapshot &graph() const { return this->_graph; }
+
+        // -1 if there is no such node; looks at every node, for a source or two and not per step
+        NodeId find(const std::string &name) const;
+
+        // Empty for -1
+        const std::string &name(NodeId id) const;
+
+    protected:
+        GraphSnapshot _graph;
+    };
+
+    // Nodes in order, e.g. a traversal or a path
+    class NodeSequence : public NodeNames {
+
+    public:
+        NodeSequence() = default;
+
+        explicit NodeSequence(const Graph *graph) : NodeNames(graph) {}
+
+        void push_back(NodeId id) { _ids.push_back(id); }
+
+        void push_back(const Node *node) { _ids.push_back(node->id()); }
+
+        void reserve(size_t count) { _ids.reserve(count); }
+
+        size_t size() const { return _ids.size(); }
+
+        bool empty() const { return _ids.empty(); }
+
+        NodeId operator[](size_t i) const { return this->_ids[i]; }
+
+        std::vector<NodeId>::const_iterator begin() const { return _ids.begin(); }
+
+        std::vector<NodeId>::const_iterator end() const { return _ids.end(); }
+
+        std::list<std::string> names() const;
+
+        // Names separated by spaces
+        friend std::ostream &operator<<(std::ostream &os, const NodeSequence &sequence);
+
+    private:
+        std::vector<NodeId> _ids;
+    };
+
+    std::ostream &operator<<(std::ostream &os, const NodeSequence &sequence);
+
+    // (from, to) steps, e.g. tree edges in the order they were found; from is -1 where a step only reaches a node
+    class NodePairSequence : public NodeNames {
+
+    public:
+        NodePairSequence() = default;
+
+        explicit NodePairSequence(const Graph *graph) : NodeNames(graph) {}
+
+        explicit NodePairSequence(const GraphSnapshot &graph) : NodeNames(graph) {}
+
+        void push_back(NodeId from, NodeId to) { _pairs.emplace_back(from, to); }
+
+        void push_back(const Node *from, const Node *to) {
+            _pairs.emplace_back(from != nullptr ? from->id() : -1, to->id());
+        }
+
+        size_t size() const { return _pairs.size(); }
+
+        bool empty() const { return _pairs.empty(); }
+
+        NodeId from(size_t i) const { return this->_pairs[i].first; }
+
+        NodeId to(size_t i) const { return this->_pairs[i].second; }
+
+        std::list<std::pair<std::string, std::string>> names() const;
+
+    private:
+        std::vector<std::pair<NodeId, NodeId>> _pairs;
+    };
+
+    // Several node sequences in one array, e.g. components or circuits
+    class NodeGroups : public NodeNames {
+
+    public:
+        NodeGroups() = default;
+
+        explicit NodeGroups(const Graph *graph) : NodeNames(graph) {}
+
+        // Later push_back calls fill the new group
+        void startGroup() { _offsets.push_back(static_cast<int>(_ids.size())); }
+
+        void push_back(NodeId id) { _ids.push_back(id); }
+
+        void push_back(const Node *node) { _ids.push_back(node->id()); }
+
+        size_t size() const { return _offsets.size(); }
+
+        bool empty() const { return _offsets.empty(); }
+
+        size_t groupSize(size_t group) const;
+
+        NodeId at(size_t group, size_t i) const { return this->_ids[_offsets[group] + i]; }
+
+        std::list<std::list<std::string>> names() const;
+
+    private:
+        std::vector<int> _offsets;
+        std::vector<NodeId> _ids;
+    };
+}
+
+#endif // NODESEQUENCE_H
@@ -0,0 +1,62 @@
+#ifndef PARALLELBFS_H
+#define PARALLELBFS_H
+
+#include "CompactGraph.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace GraphType {
+
+    /*
+     * Direction-optimizing breadth-first search (Beamer, Asanovic, Patterson).
+     * Levels are expanded top-down from the frontier while it is small and bottom-up,
+     * every unvisited node looking for a parent in the frontier, while it is large.
+     * Frontiers and the visited set are bitsets, each level is split across the
+     * TaskScheduler and top-down steps claim nodes with an atomic or on their visited bit.
+     */
+    class ParallelBFS {
+
+    public:
+        struct Options {
+            // Bottom-up once the frontier's arcs exceed 1/alpha of the unexplored ones
+            double alpha = 15;
+            // Top-down again once the frontier holds fewer than 1/beta of the nodes
+            double beta = 18;
+        };
+
+        // Arcs are followed forwards; bottom-up steps need them backwards, which a non symmetric graph gets copied for
+        ParallelBFS(const CompactGraph &graph, const Options &options);
+
+        // depth and parent are -1 for nodes not reached, the source is its own parent;
+        // the parent is the lowest id one level up, so it does not depend on who won a claim
+        void run(int source, std::vector<int> &depth, std::vector<int> &parent);
+
+        int topDownSteps() const { return this->_topDownSteps; }
+
+        int bottomUpSteps() const { return this->_bottomUpSteps; }
+
+    private:
+        typedef std::uint64_t Word;
+
+        const CompactGraph &_graph;
+        Options _options;
+        // Incoming arcs, an empty graph when the graph is symmetric
+        CompactGraph _reverse;
+        std::vector<std::atomic<Word>> _visited;
+        std::vector<std::atomic<Word>> _frontier, _next;
+        int _topDownSteps = 0;
+        int _bottomUpSteps = 0;
+
+        const CompactGraph &incoming() const { return _graph.isSymmetric() ? _graph : _reverse; }
+
+        // Returns the arcs leaving the new frontier, adds its nodes to `count`
+        long long topDown(int level, std::vector<int> &depth, std::vector<int> &parent, long long &count);
+
+        long long bottomUp(int level, std::vector<int> &depth, std::vector<int> &parent, long long &count);
+
+        void settleParents(const std::vector<int> &depth, std::vector<int> &parent);
+    };
+}
+
+#endif // PARALLELBFS_H
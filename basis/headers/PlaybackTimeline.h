@@ -0,0 +1,89 @@
+#ifndef PLAYBACKTIMELINE_H
+#define PLAYBACKTIMELINE_H
+
+#include "NodeSequence.h"
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace GraphType {
+
+    /*
+     * An algorithm result turned into steps of changes to how nodes and edges are shown.
+     * Every change keeps the state it replaces, so playback can run both ways and jump
+     * to any step by undoing or redoing only the changes in between.
+     */
+    class PlaybackTimeline {
+
+    public:
+        // States: -1 not selected, 0 selected, k > 0 selected in the k-th colour
+        struct Change {
+            NodeId u;
+            NodeId v;
+            int before;
+            int after;
+        };
+
+        PlaybackTimeline() = default;
+
+        // Names come from the snapshot the result was computed on
+        explicit PlaybackTimeline(const NodeNames &names);
+
+        const NodeNames &names() const { return this->_names; }
+
+        // Later changes belong to the new step
+        void startStep();
+
+        // Ids of -1 are skipped
+        void setNode(NodeId id, int state);
+
+        void setEdge(NodeId u, NodeId v, int state);
+
+        // Unselects everything selected by the steps so far
+        void clear();
+
+        size_t size() const { return _steps.size(); }
+
+        bool empty() const { return _steps.empty(); }
+
+        int countColors() const { return this->_colors; }
+
+        // Steps shown so far
+        size_t position() const { return this->_position; }
+
+        // Shows the first `step` steps, calling apply(u, v, state) for every change redone or undone on the way;
+        // v is -1 for a node
+        template<typename Apply>
+        void seek(size_t step, Apply apply) {
+            step = std::min(step, size());
+            for (; _position < step; ++_position) {
+                for (size_t i = _steps[_position]; i < stepEnd(_position); ++i)
+                    apply(_changes[i].u, _changes[i].v, _changes[i].after);
+            }
+            for (; _position > step; --_position) {
+                for (size_t i = stepEnd(_position - 1); i-- > _steps[_position - 1];)
+                    apply(_changes[i].u, _changes[i].v, _changes[i].before);
+            }
+        }
+
+    private:
+        NodeNames _names;
+        std::vector<Change> _changes;
+        std::vector<size_t> _steps;
+        size_t _position = 0;
+        int _colors = 0;
+
+        // What the steps built so far end with
+        bool _directed = false;
+        std::vector<int> _nodeStates;
+        std::unordered_map<long long, int> _edgeStates;
+        std::vector<std::pair<NodeId, NodeId>> _selected;
+
+        size_t stepEnd(size_t step) const { return step + 1 < _steps.size() ? _steps[step + 1] : _changes.size(); }
+
+        void record(NodeId u, NodeId v, int &current, int state);
+    };
+}
+
+#endif // PLAYBACKTIMELINE_H
@@ -0,0 +1,24 @@
+#ifndef POINT_H
+#define POINT_H
+
+namespace GraphType {
+
+    // Position of a node. The graph core builds without Qt, graphics/headers/QtPoint.h converts for the GUI
+    class Point {
+
+    public:
+        Point() = default;
+
+        Point(double x, double y) : _x(x), _y(y) {}
+
+        double x() const { return this->_x; }
+
+        double y() const { return this->_y; }
+
+    private:
+        double _x = 0;
+        double _y = 0;
+    };
+}
+
+#endif // POINT_H
@@ -0,0 +1,102 @@
+#ifndef TASKSCHEDULER_H
+#define TASKSCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GraphType {
+
+    /*
+     * Work-stealing pool shared by the parallel graph kernels and layouts.
+     * Every worker has its own deque, runs its newest task first and steals the oldest
+     * task of another deque when it runs dry. Threads outside the pool queue their tasks
+     * on a shared deque and help with the work while they wait, so a kernel started from
+     * the GUI or from QtConcurrent never blocks a thread that could compute.
+     * Tasks run under the AlgorithmContext of the thread that queued them.
+     */
+    class TaskScheduler {
+
+    public:
+        typedef std::function<void()> Task;
+
+        // Tasks queued together, wait() returns once all of them have run
+        class TaskGroup {
+        public:
+            TaskGroup() = default;
+
+            TaskGroup(const TaskGroup &) = delete;
+
+            TaskGroup &operator=(const TaskGroup &) = delete;
+
+            ~TaskGroup();
+
+            void run(Task task);
+
+            // Runs queued tasks meanwhile and sleeps when there are none,
+            // rethrows the first exception one of the group's tasks threw
+            void wait();
+
+        private:
+            std::atomic<int> _pending{0};
+            std::mutex _mutex;
+            std::exception_ptr _error;
+
+            void finish();
+        };
+
+        static TaskScheduler &instance();
+
+        // Threads computing at once including the one waiting for the work, 0 uses every hardware thread
+        static void setThreadCount(int count);
+
+        static int threadCount();
+
+        // Calls body(from, to) on disjoint slices of [begin, end), no slice shorter than minGrain unless the range is
+        static void parallelFor(int begin, int end, const std::function<void(int, int)> &body, int minGrain = 1);
+
+        ~TaskScheduler();
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        static const int _maxThreads = 256;
+
+        // Queue 0 is shared by threads outside the pool, worker i owns queue i
+        std::vector<std::unique_ptr<Queue>> _queues;
+        std::vector<std::thread> _workers;
+        std::mutex _workersMutex;
+        std::atomic<int> _active{1};
+        std::atomic<int> _queueCount{1};
+        std::atomic<int> _queued{0};
+        std::atomic<bool> _stopping{false};
+        // Idle workers and waiting groups sleep on _wake, workers beyond the count on _parked,
+        // so a task pushed wakes a thread that can run it
+        std::mutex _sleepMutex;
+        std::condition_variable _wake;
+        std::condition_variable _parked;
+
+        static thread_local int _workerIndex;
+
+        TaskScheduler();
+
+        void resize(int threads);
+
+        void push(Task task);
+
+        bool take(Task &task);
+
+        void work(int index);
+    };
+}
+
+#endif // TASKSCHEDULER_H
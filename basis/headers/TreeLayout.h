@@ -0,0 +1,57 @@
+#ifndef TREELAYOUT_H
+#define TREELAYOUT_H
+
+#include "NodeSequence.h"
+#include <vector>
+
+namespace GraphType {
+
+    /*
+     * Tidy drawing of a rooted tree or forest given as (parent, child) pairs, as returned by
+     * the spanning tree and traversal utilities. Walker's algorithm in the linear time form of
+     * Buchheim, Juenger and Leipert, walked without recursion so that paths of any depth work.
+     */
+    class TreeLayout {
+
+    public:
+        struct Options {
+            double siblingSpacing = 80;
+            double levelSpacing = 100;
+            // Levels become circles around the root instead of rows below it
+            bool radial = false;
+        };
+
+        // A child's last pair wins, which is how Prim reports improved keys; a parent of -1 marks a root
+        TreeLayout(const NodePairSequence &edges, const Options &options);
+
+        // Ids of the graph the edges were found on
+        const std::vector<NodeId> &nodes() const { return this->_ids; }
+
+        // Positions in the order of nodes(), the first root at the origin
+        void run(std::vector<double> &x, std::vector<double> &y);
+
+    private:
+        Options _options;
+        std::vector<NodeId> _ids;
+        // The last id is a virtual root above all roots of the forest
+        std::vector<std::vector<int>> _children;
+        std::vector<int> _parent, _number, _thread, _ancestor;
+        std::vector<double> _prelim, _mod, _shift, _change, _midpoint;
+
+        int nextLeft(int v) const { return _children[v].empty() ? _thread[v] : _children[v].front(); }
+
+        int nextRight(int v) const { return _children[v].empty() ? _thread[v] : _children[v].back(); }
+
+        int leftSibling(int v) const { return _number[v] > 0 ? _children[_parent[v]][_number[v] - 1] : -1; }
+
+        void place(int v);
+
+        int apportion(int v, int defaultAncestor);
+
+        void moveSubtree(int left, int right, double shift);
+
+        void executeShifts(int v);
+    };
+}
+
+#endif // TREELAYOUT_H
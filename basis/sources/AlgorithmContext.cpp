@@ -0,0 +1,36 @@
+#include "basis/headers/AlgorithmContext.h"
+
+using namespace GraphType;
+
+thread_local AlgorithmContext *AlgorithmContext::_current = nullptr;
+
+void AlgorithmContext::write(const char *s, std::size_t n) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    this->_output.append(s, n);
+}
+
+std::string AlgorithmContext::takeOutput() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::string output;
+    output.swap(_output);
+    return output;
+}
+
+AlgorithmContext::Output::int_type AlgorithmContext::Output::overflow(int_type c) {
+    if (traits_type::eq_int_type(c, traits_type::eof()))
+        return traits_type::not_eof(c);
+    char ch = traits_type::to_char_type(c);
+    return xsputn(&ch, 1) == 1 ? c : traits_type::eof();
+}
+
+std::streamsize AlgorithmContext::Output::xsputn(const char *s, std::streamsize n) {
+    if (_current != nullptr) {
+        _current->write(s, static_cast<std::size_t>(n));
+        return n;
+    }
+    return _fallback != nullptr ? _fallback->sputn(s, n) : n;
+}
+
+int AlgorithmContext::Output::sync() {
+    return _current == nullptr && _fallback != nullptr ? _fallback->pubsync() : 0;
+}
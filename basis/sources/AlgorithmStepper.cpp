@@ -0,0 +1,102 @@
+#include "basis/headers/AlgorithmStepper.h"
+#include <climits>
+
+using namespace GraphType;
+
+AlgorithmStepper::AlgorithmStepper(const Graph *graph, const std::string &source) :
+        _names(graph),
+        _compact(_names.graph()),
+        _source(graph->hasNode(source) ? _compact.fromSnapshotId(graph->node(source)->id()) : -1),
+        _parent(_compact.countNodes(), -1) {}
+
+AlgorithmStepper::Step AlgorithmStepper::step(int v) const {
+    return {_parent[v] >= 0 ? _compact.snapshotId(_parent[v]) : -1, _compact.snapshotId(v)};
+}
+
+BFSStepper::BFSStepper(const Graph *graph, const std::string &source) :
+        AlgorithmStepper(graph, source),
+        _targets(_compact.sortedTargets()),
+        _visited(_compact.countNodes(), false) {
+    if (_source >= 0) {
+        _queue.push(_source);
+        _visited[_source] = true;
+    }
+}
+
+bool BFSStepper::next(Step &step) {
+    if (_queue.empty())
+        return false;
+    int u = _queue.front();
+    _queue.pop();
+    for (int arc = _compact.arcBegin(u); arc < _compact.arcEnd(u); ++arc) {
+        int v = _targets[arc];
+        if (!_visited[v]) {
+            _visited[v] = true;
+            _queue.push(v);
+            _parent[v] = u;
+        }
+    }
+    step = this->step(u);
+    return true;
+}
+
+DFSStepper::DFSStepper(const Graph *graph, const std::string &source) :
+        AlgorithmStepper(graph, source),
+        _targets(_compact.sortedTargets()),
+        _visited(_compact.countNodes(), false) {
+    if (_source >= 0)
+        _stack.push_back(_source);
+}
+
+bool DFSStepper::next(Step &step) {
+    // A node may be on the stack several times, the last push is the tree edge
+    while (!_stack.empty() && _visited[_stack.back()])
+        _stack.pop_back();
+    if (_stack.empty())
+        return false;
+    int u = _stack.back();
+    _stack.pop_back();
+    _visited[u] = true;
+    for (int arc = _compact.arcBegin(u); arc < _compact.arcEnd(u); ++arc) {
+        int v = _targets[arc];
+        if (!_visited[v]) {
+            _stack.push_back(v);
+            _parent[v] = u;
+        }
+    }
+    step = this->step(u);
+    return true;
+}
+
+DijkstraStepper::DijkstraStepper(const Graph *graph, const std::string &source, bool spanning) :
+        AlgorithmStepper(graph, source),
+        _spanning(spanning),
+        _key(_compact.countNodes(), LLONG_MAX),
+        _settled(_compact.countNodes(), false) {
+    if (_source >= 0) {
+        _key[_source] = 0;
+        _queue.emplace(0, _source);
+    }
+}
+
+bool DijkstraStepper::next(Step &step) {
+    while (!_queue.empty() && _settled[_queue.top().second])
+        _queue.pop();
+    if (_queue.empty())
+        return false;
+    auto item = _queue.top();
+    _queue.pop();
+    int u = item.second;
+    _settled[u] = true;
+    for (int arc = _compact.arcBegin(u); arc < _compact.arcEnd(u); ++arc) {
+        int v = _compact.target(arc);
+        long long key = _spanning ? _compact.weight(arc) : item.first + _compact.weight(arc);
+        if (!_settled[v] && key < _key[v]) {
+            _key[v] = key;
+            _parent[v] = u;
+            _queue.emplace(key, v);
+        }
+    }
+    step = this->step(u);
+    return true;
+}
@@ -0,0 +1,118 @@
+#include "basis/headers/CompactGraph.h"
+#include <algorithm>
+
+using namespace GraphType;
+
+CompactGraph::CompactGraph(const Graph &graph, bool symmetric) {
+    auto nodes = graph.nodeList();
+    _nodes.reserve(nodes.size());
+    _ids.reserve(nodes.size());
+    for (auto node: nodes) {
+        _ids[node] = static_cast<int>(_nodes.size());
+        _nodes.push_back(node);
+    }
+    // Undirected edges are stored once, in whichever orientation they were set
+    bool both = symmetric || graph.isUndirected();
+    this->_symmetric = both;
+    auto n = static_cast<int>(_nodes.size());
+    _offsets.assign(n + 1, 0);
+    for (const auto &it: graph.edgeSet()) {
+        ++_offsets[_ids[it.first.first] + 1];
+        if (both && it.first.first != it.first.second)
+            ++_offsets[_ids[it.first.second] + 1];
+    }
+    for (int i = 0; i < n; ++i)
+        _offsets[i + 1] += _offsets[i];
+    _targets.resize(_offsets[n]);
+    _weights.resize(_offsets[n]);
+    std::vector<int> fill(_offsets.begin(), _offsets.end() - 1);
+    for (const auto &it: graph.edgeSet()) {
+        int u = _ids[it.first.first], v = _ids[it.first.second];
+        _targets[fill[u]] = v;
+        _weights[fill[u]++] = it.second;
+        if (both && u != v) {
+            _targets[fill[v]] = u;
+            _weights[fill[v]++] = it.second;
+        }
+    }
+}
+
+CompactGraph::CompactGraph(const GraphSnapshot &snapshot) :
+        _snapshotIds(snapshot.nodeIds()),
+        _symmetric(!snapshot.isDirected()) {
+    auto n = static_cast<int>(_snapshotIds.size());
+    auto &index = this->_fromSnapshot;
+    index.assign(snapshot.nodeCapacity(), -1);
+    for (int i = 0; i < n; ++i)
+        index[_snapshotIds[i]] = i;
+    _offsets.assign(n + 1, 0);
+    for (int id = 0; id < snapshot.edgeCapacity(); ++id) {
+        if (!snapshot.hasEdge(id))
+            continue;
+        const auto &edge = snapshot.edge(id);
+        ++_offsets[index[edge.u] + 1];
+        if (_symmetric && edge.u != edge.v)
+            ++_offsets[index[edge.v] + 1];
+    }
+    for (int i = 0; i < n; ++i)
+        _offsets[i + 1] += _offsets[i];
+    _targets.resize(_offsets[n]);
+    _weights.resize(_offsets[n]);
+    std::vector<int> fill(_offsets.begin(), _offsets.end() - 1);
+    for (int id = 0; id < snapshot.edgeCapacity(); ++id) {
+        if (!snapshot.hasEdge(id))
+            continue;
+        const auto &edge = snapshot.edge(id);
+        int u = index[edge.u], v = index[edge.v];
+        _targets[fill[u]] = v;
+        _weights[fill[u]++] = edge.weight;
+        if (_symmetric && u != v) {
+            _targets[fill[v]] = u;
+            _weights[fill[v]++] = edge.weight;
+        }
+    }
+}
+
+CompactGraph::CompactGraph(std::vector<int> offsets, std::vector<int> targets, std::vector<int> weights) :
+        _offsets(std::move(offsets)),
+        _targets(std::move(targets)),
+        _weights(std::move(weights)) {
+    if (_offsets.empty())
+        _offsets.push_back(0);
+}
+
+CompactGraph CompactGraph::reversed() const {
+    int n = countNodes();
+    std::vector<int> offsets(n + 1, 0), targets(_targets.size()), weights(_weights.size());
+    for (int target: _targets)
+        ++offsets[target + 1];
+    for (int v = 0; v < n; ++v)
+        offsets[v + 1] += offsets[v];
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (int u = 0; u < n; ++u) {
+        for (int arc = _offsets[u]; arc < _offsets[u + 1]; ++arc) {
+            int i = fill[_targets[arc]]++;
+            targets[i] = u;
+            weights[i] = _weights[arc];
+        }
+    }
+    CompactGraph reversed(std::move(offsets), std::move(targets), std::move(weights));
+    reversed._symmetric = _symmetric;
+    return reversed;
+}
+
+std::vector<int> CompactGraph::sortedTargets() const {
+    auto targets = _targets;
+    for (int u = 0; u < countNodes(); ++u)
+        std::sort(targets.begin() + _offsets[u], targets.begin() + _offsets[u + 1]);
+    return targets;
+}
+
+int CompactGraph::fromSnapshotId(int id) const {
+    return id >= 0 && id < static_cast<int>(_fromSnapshot.size()) ? _fromSnapshot[id] : -1;
+}
+
+int CompactGraph::id(const Node *node) const {
+    auto it = _ids.find(node);
+    return it != _ids.end() ? it->second : -1;
+}
@@ -0,0 +1,356 @@
+#include "basis/headers/ContractionHierarchy.h"
+#include "basis/headers/AlgorithmContext.h"
+#include "basis/headers/TaskScheduler.h"
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+using namespace GraphType;
+
+namespace {
+    struct DynamicArc {
+        int node;
+        int middle;
+        long long weight;
+    };
+
+    // The graph left while contracting, with the shortcuts added so far and contracted nodes removed
+    class Builder {
+    public:
+        std::vector<std::vector<DynamicArc>> out, in;
+        std::vector<int> contractedNeighbours;
+        int shortcuts = 0;
+        long long arcs = 0;
+
+        Builder(const CompactGraph &graph, const ContractionHierarchy::Options &options) :
+                out(graph.countNodes()),
+                in(graph.countNodes()),
+                contractedNeighbours(graph.countNodes(), 0),
+                _options(options),
+                _distance(graph.countNodes(), LLONG_MAX) {
+            // Parallel arcs collapse into the lightest one, loops are dropped
+            std::vector<std::pair<int, int>> sorted;
+            for (int u = 0; u < graph.countNodes(); ++u) {
+                sorted.clear();
+                for (int arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) {
+                    if (graph.target(arc) != u)
+                        sorted.emplace_back(graph.target(arc), graph.weight(arc));
+                }
+                std::sort(sorted.begin(), sorted.end());
+                for (size_t i = 0; i < sorted.size(); ++i) {
+                    if (i > 0 && sorted[i].first == sorted[i - 1].first)
+                        continue;
+                    out[u].push_back({sorted[i].first, -1, sorted[i].second});
+                    in[sorted[i].first].push_back({u, -1, sorted[i].second});
+                    ++this->arcs;
+                }
+            }
+        }
+
+        int priority(int v) {
+            int difference = shortcutsFor(v, std::max(1, _options.witnessSettled / 5), false)
+                             - static_cast<int>(in[v].size() + out[v].size());
+            return 2 * difference + contractedNeighbours[v];
+        }
+
+        void contract(int v) {
+            this->shortcuts += shortcutsFor(v, _options.witnessSettled, true);
+            auto detach = [](std::vector<DynamicArc> &arcs, int node) {
+                arcs.erase(std::remove_if(arcs.begin(), arcs.end(), [node](const DynamicArc &arc) {
+                    return arc.node == node;
+                }), arcs.end());
+            };
+            this->arcs -= out[v].size() + in[v].size();
+            for (const auto &arc: out[v]) {
+                detach(in[arc.node], v);
+                ++contractedNeighbours[arc.node];
+            }
+            for (const auto &arc: in[v]) {
+                detach(out[arc.node], v);
+                ++contractedNeighbours[arc.node];
+            }
+        }
+
+    private:
+        const ContractionHierarchy::Options &_options;
+        std::vector<long long> _distance;
+        std::vector<int> _touched;
+
+        void addArc(int u, int w, long long weight, int middle) {
+            for (auto &arc: out[u]) {
+                if (arc.node != w)
+                    continue;
+                if (weight < arc.weight) {
+                    arc.weight = weight;
+                    arc.middle = middle;
+                    for (auto &back: in[w]) {
+                        if (back.node == u) {
+                            back.weight = weight;
+                            back.middle = middle;
+                            break;
+                        }
+                    }
+                }
+                return;
+            }
+            out[u].push_back({w, middle, weight});
+            in[w].push_back({u, middle, weight});
+            ++arcs;
+        }
+
+        // Distances from source without passing skip, exact up to limit or until maxSettled nodes are settled
+        void witness(int source, int skip, long long limit, int maxSettled) {
+            typedef std::pair<long long, int> Item;
+            std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+            _distance[source] = 0;
+            _touched.push_back(source);
+            queue.emplace(0, source);
+            int settled = 0;
+            while (!queue.empty() && settled < maxSettled) {
+                auto item = queue.top();
+                queue.pop();
+                if (item.first > _distance[item.second])
+                    continue;
+                if (item.first > limit)
+                    break;
+                ++settled;
+                for (const auto &arc: out[item.second]) {
+                    if (arc.node == skip)
+                        continue;
+                    long long distance = item.first + arc.weight;
+                    if (distance < _distance[arc.node]) {
+                        if (_distance[arc.node] == LLONG_MAX)
+                            _touched.push_back(arc.node);
+                        _distance[arc.node] = distance;
+                        queue.emplace(distance, arc.node);
+                    }
+                }
+            }
+        }
+
+        void resetWitness() {
+            for (int v: _touched)
+                _distance[v] = LLONG_MAX;
+            _touched.clear();
+        }
+
+        // Pairs of neighbours without a path as short as the one through v, added as shortcuts if asked to
+        int shortcutsFor(int v, int maxSettled, bool add) {
+            long long longestOut = 0;
+            for (const auto &arc: out[v])
+                longestOut = std::max(longestOut, arc.weight);
+            int count = 0;
+            for (size_t i = 0; i < in[v].size(); ++i) {
+                auto incoming = in[v][i];
+                witness(incoming.node, v, incoming.weight + longestOut, maxSettled);
+                for (size_t j = 0; j < out[v].size(); ++j) {
+                    auto outgoing = out[v][j];
+                    long long via = incoming.weight + outgoing.weight;
+                    if (outgoing.node == incoming.node || _distance[outgoing.node] <= via)
+                        continue;
+                    ++count;
+                    if (add)
+                        addArc(incoming.node, outgoing.node, via, v);
+                }
+                resetWitness();
+            }
+            return count;
+        }
+    };
+}
+
+const long long ContractionHierarchy::unreachable;
+
+ContractionHierarchy::ContractionHierarchy(const CompactGraph &graph, const Options &options) {
+    int n = graph.countNodes();
+    Builder builder(graph, options);
+    _up.resize(n);
+    _down.resize(n);
+    auto keep = [](const std::vector<DynamicArc> &arcs, std::vector<Arc> &kept) {
+        kept.reserve(arcs.size());
+        for (const auto &arc: arcs)
+            kept.push_back({arc.node, arc.middle, arc.weight});
+    };
+
+    // Priorities only grow as neighbours go, so a node whose fresh priority is still the lowest is due
+    typedef std::pair<int, int> Item;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+    for (int v = 0; v < n; ++v)
+        queue.emplace(builder.priority(v), v);
+    std::vector<bool> contracted(n, false);
+    while (!queue.empty()) {
+        int v = queue.top().second;
+        queue.pop();
+        int priority = builder.priority(v);
+        if (!queue.empty() && priority > queue.top().first) {
+            queue.emplace(priority, v);
+            continue;
+        }
+        auto degree_product = static_cast<long long>(builder.in[v].size()) * static_cast<long long>(builder.out[v].size());
+        if (degree_product > options.maxDegreeProduct
+            || builder.arcs > options.maxMeanDegree * static_cast<long long>(queue.size() + 1)) {
+            queue.emplace(priority, v);
+            break;
+        }
+        AlgorithmContext::step();
+        // What is left next to v now all ranks higher
+        keep(builder.out[v], _up[v]);
+        keep(builder.in[v], _down[v]);
+        builder.contract(v);
+        contracted[v] = true;
+        std::vector<DynamicArc>().swap(builder.out[v]);
+        std::vector<DynamicArc>().swap(builder.in[v]);
+    }
+    for (int v = 0; v < n; ++v) {
+        if (contracted[v])
+            continue;
+        keep(builder.out[v], _up[v]);
+        keep(builder.in[v], _down[v]);
+        ++_coreSize;
+    }
+    this->_shortcuts = builder.shortcuts;
+}
+
+void ContractionHierarchy::search(int origin, bool forward, Space &space) const {
+    for (int v: space.touched)
+        space.labels[v].distance = unreachable;
+    space.touched.clear();
+    space.settled.clear();
+    if (space.labels.empty())
+        space.labels.assign(_up.size(), {unreachable, -1, -1});
+
+    typedef std::pair<long long, int> Item;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+    space.labels[origin] = {0, -1, -1};
+    space.touched.push_back(origin);
+    queue.emplace(0, origin);
+    while (!queue.empty()) {
+        auto item = queue.top();
+        queue.pop();
+        int u = item.second;
+        if (item.first > space.labels[u].distance)
+            continue;
+        AlgorithmContext::step();
+        space.settled.emplace_back(u, item.first);
+        for (const auto &arc: forward ? _up[u] : _down[u]) {
+            long long distance = item.first + arc.weight;
+            auto &label = space.labels[arc.node];
+            if (distance < label.distance) {
+                if (label.distance == unreachable)
+                    space.touched.push_back(arc.node);
+                label = {distance, u, arc.middle};
+                queue.emplace(distance, arc.node);
+            }
+        }
+    }
+}
+
+void ContractionHierarchy::unpack(int from, int to, int middle, std::vector<int> &path) const {
+    struct Step {
+        int from, to, middle;
+    };
+    auto middleOf = [](const std::vector<Arc> &arcs, int node) {
+        for (const auto &arc: arcs) {
+            if (arc.node == node)
+                return arc.middle;
+        }
+        return -1;
+    };
+    // The bypassed node ranks below both ends: from -> middle enters it, middle -> to leaves it
+    std::vector<Step> stack{{from, to, middle}};
+    while (!stack.empty()) {
+        auto step = stack.back();
+        stack.pop_back();
+        if (step.middle < 0) {
+            path.push_back(step.to);
+            continue;
+        }
+        stack.push_back({step.middle, step.to, middleOf(_up[step.middle], step.to)});
+        stack.push_back({step.from, step.middle, middleOf(_down[step.middle], step.from)});
+    }
+}
+
+void ContractionHierarchy::manyToMany(const std::vector<int> &sources, const std::vector<int> &targets,
+                                      std::vector<long long> &distances, std::vector<std::vector<int>> *paths) const {
+    auto rows = static_cast<int>(sources.size()), columns = static_cast<int>(targets.size());
+    distances.assign(static_cast<size_t>(rows) * columns, unreachable);
+    if (paths != nullptr)
+        paths->assign(distances.size(), std::vector<int>());
+    if (rows == 0 || columns == 0)
+        return;
+
+    // Settled nodes of every backward search, and for paths the labels they were settled with
+    std::vector<std::vector<std::pair<int, long long>>> spaces(columns);
+    std::vector<std::unordered_map<int, Label>> backward(paths != nullptr ? columns : 0);
+    TaskScheduler::parallelFor(0, columns, [&](int from, int to) {
+        Space space;
+        for (int j = from; j < to; ++j) {
+            search(targets[j], false, space);
+            spaces[j] = space.settled;
+            if (paths == nullptr)
+                continue;
+            for (const auto &settled: space.settled)
+                backward[j][settled.first] = space.labels[settled.first];
+        }
+    });
+
+    // Bucket of a node: every target whose backward search settled it, with the distance left
+    struct Entry {
+        int column;
+        long long distance;
+    };
+    auto n = static_cast<int>(_up.size());
+    std::vector<int> offsets(n + 1, 0);
+    for (const auto &space: spaces) {
+        for (const auto &settled: space)
+            ++offsets[settled.first + 1];
+    }
+    for (int v = 0; v < n; ++v)
+        offsets[v + 1] += offsets[v];
+    std::vector<Entry> buckets(offsets[n]);
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (int j = 0; j < columns; ++j) {
+        for (const auto &settled: spaces[j])
+            buckets[fill[settled.first]++] = {j, settled.second};
+        std::vector<std::pair<int, long long>>().swap(spaces[j]);
+    }
+
+    TaskScheduler::parallelFor(0, rows, [&](int from, int to) {
+        Space space;
+        std::vector<int> meeting(columns);
+        for (int i = from; i < to; ++i) {
+            search(sources[i], true, space);
+            long long *row = &distances[static_cast<size_t>(i) * columns];
+            std::fill(meeting.begin(), meeting.end(), -1);
+            for (const auto &node: space.settled) {
+                for (int e = offsets[node.first]; e < offsets[node.first + 1]; ++e) {
+                    long long distance = node.second + buckets[e].distance;
+                    if (distance < row[buckets[e].column]) {
+                        row[buckets[e].column] = distance;
+                        meeting[buckets[e].column] = node.first;
+                    }
+                }
+            }
+            if (paths == nullptr)
+                continue;
+            for (int j = 0; j < columns; ++j) {
+                if (meeting[j] < 0)
+                    continue;
+                auto &path = (*paths)[static_cast<size_t>(i) * columns + j];
+                // Up from the source to the meeting node, then down to the target
+                std::vector<int> climb;
+                for (int v = meeting[j]; v != sources[i]; v = space.labels[v].parent)
+                    climb.push_back(v);
+                path.push_back(sources[i]);
+                int at = sources[i];
+                for (auto it = climb.rbegin(); it != climb.rend(); ++it) {
+                    unpack(at, *it, space.labels[*it].middle, path);
+                    at = *it;
+                }
+                const auto &down = backward[j];
+                for (int v = meeting[j]; v != targets[j]; v = down.at(v).parent)
+                    unpack(v, down.at(v).parent, down.at(v).middle, path);
+            }
+        }
+    });
+}
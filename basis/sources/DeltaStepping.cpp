@@ -0,0 +1,148 @@
+#include "basis/headers/DeltaStepping.h"
+#include "basis/headers/AlgorithmContext.h"
+#include "basis/headers/TaskScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+
+using namespace GraphType;
+
+namespace {
+    // Lowers `value` to `candidate`, returns whether it did
+    inline bool fetchMin(std::atomic<long long> &value, long long candidate) {
+        long long current = value.load(std::memory_order_relaxed);
+        while (candidate < current) {
+            if (value.compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+                return true;
+        }
+        return false;
+    }
+}
+
+const long long DeltaStepping::unreachable;
+
+DeltaStepping::DeltaStepping(const CompactGraph &graph, const Options &options) :
+        _graph(graph),
+        _delta(options.delta) {
+    if (_delta > 0)
+        return;
+    // Four mean weights per mean degree: wide enough for rounds with lots of nodes,
+    // narrow enough that few of them are reached with a distance that is lowered again later
+    long long arcs = _graph.countArcs();
+    double sum = 0;
+    for (long long arc = 0; arc < arcs; ++arc)
+        sum += _graph.weight(static_cast<int>(arc));
+    double meanWeight = arcs > 0 ? sum / arcs : 1;
+    double meanDegree = _graph.countNodes() > 0 ? static_cast<double>(arcs) / _graph.countNodes() : 1;
+    this->_delta = std::max(1LL, std::llround(meanWeight * 4 / std::max(1., meanDegree)));
+}
+
+std::vector<std::pair<long long, int>> DeltaStepping::relax(const std::vector<int> &nodes, bool light) {
+    std::vector<std::pair<long long, int>> lowered;
+    std::mutex mutex;
+    TaskScheduler::parallelFor(0, static_cast<int>(nodes.size()), [&](int from, int to) {
+        std::vector<std::pair<long long, int>> local;
+        for (int i = from; i < to; ++i) {
+            int u = nodes[i];
+            long long du = _distance[u].load(std::memory_order_relaxed);
+            for (int arc = _graph.arcBegin(u); arc < _graph.arcEnd(u); ++arc) {
+                long long w = _graph.weight(arc);
+                if ((w <= _delta) != light)
+                    continue;
+                int v = _graph.target(arc);
+                if (fetchMin(_distance[v], du + w))
+                    local.emplace_back((du + w) / _delta, v);
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        lowered.insert(lowered.end(), local.begin(), local.end());
+    }, 64);
+    return lowered;
+}
+
+void DeltaStepping::run(int source, std::vector<long long> &distance, std::vector<int> &parent) {
+    int n = _graph.countNodes();
+    distance.assign(n, unreachable);
+    parent.assign(n, -1);
+    this->_rounds = 0;
+    if (source < 0 || source >= n)
+        return;
+    if (static_cast<int>(_distance.size()) != n) {
+        this->_distance = std::vector<std::atomic<long long>>(n);
+        this->_lightMark = std::vector<std::atomic<long long>>(n);
+        this->_heavyMark = std::vector<std::atomic<long long>>(n);
+    }
+    TaskScheduler::parallelFor(0, n, [this](int from, int to) {
+        for (int v = from; v < to; ++v) {
+            _distance[v].store(unreachable, std::memory_order_relaxed);
+            _lightMark[v].store(-1, std::memory_order_relaxed);
+            _heavyMark[v].store(-1, std::memory_order_relaxed);
+        }
+    }, 4096);
+    _distance[source].store(0);
+
+    // Nodes are queued again whenever their distance drops, stale entries are dropped when their bucket comes up
+    std::map<long long, std::vector<int>> buckets;
+    buckets[0].push_back(source);
+    auto enqueue = [&buckets](const std::vector<std::pair<long long, int>> &lowered) {
+        std::vector<int> *last = nullptr;
+        long long lastBucket = -1;
+        for (const auto &entry: lowered) {
+            if (entry.first != lastBucket) {
+                last = &buckets[entry.first];
+                lastBucket = entry.first;
+            }
+            last->push_back(entry.second);
+        }
+    };
+    // Keeps the entries still in `bucket` that were not expanded with `mark` yet
+    auto expand = [this](std::vector<int> &nodes, long long bucket, std::vector<std::atomic<long long>> &marks,
+                         long long mark) {
+        auto end = std::remove_if(nodes.begin(), nodes.end(), [&](int v) {
+            return _distance[v].load(std::memory_order_relaxed) / _delta != bucket || marks[v].exchange(mark) == mark;
+        });
+        nodes.erase(end, nodes.end());
+    };
+
+    while (!buckets.empty()) {
+        long long bucket = buckets.begin()->first;
+        std::vector<int> settled;
+        while (!buckets.empty() && buckets.begin()->first == bucket) {
+            auto nodes = std::move(buckets.begin()->second);
+            buckets.erase(buckets.begin());
+            expand(nodes, bucket, _lightMark, _rounds++);
+            AlgorithmContext::step(static_cast<long long>(nodes.size()));
+            enqueue(relax(nodes, true));
+            settled.insert(settled.end(), nodes.begin(), nodes.end());
+        }
+        // Distances in the bucket are final now, heavy arcs only reach later buckets
+        expand(settled, bucket, _heavyMark, bucket);
+        enqueue(relax(settled, false));
+    }
+
+    // The lowest tight predecessor becomes the parent, the marks are free to hold it
+    TaskScheduler::parallelFor(0, n, [this](int from, int to) {
+        for (int v = from; v < to; ++v)
+            _lightMark[v].store(LLONG_MAX, std::memory_order_relaxed);
+    }, 4096);
+    TaskScheduler::parallelFor(0, n, [&](int from, int to) {
+        for (int u = from; u < to; ++u) {
+            long long du = _distance[u].load(std::memory_order_relaxed);
+            if (du == unreachable)
+                continue;
+            for (int arc = _graph.arcBegin(u); arc < _graph.arcEnd(u); ++arc) {
+                int v = _graph.target(arc);
+                if (v != source && du + _graph.weight(arc) == _distance[v].load(std::memory_order_relaxed))
+                    fetchMin(_lightMark[v], u);
+            }
+        }
+    }, 256);
+    TaskScheduler::parallelFor(0, n, [&](int from, int to) {
+        for (int v = from; v < to; ++v) {
+            distance[v] = _distance[v].load(std::memory_order_relaxed);
+            long long p = _lightMark[v].load(std::memory_order_relaxed);
+            parent[v] = v == source ? source : (p == LLONG_MAX ? -1 : static_cast<int>(p));
+        }
+    }, 4096);
+}
@@ -0,0 +1,198 @@
+#include "basis/headers/DistanceTable.h"
+#include "basis/headers/AlgorithmContext.h"
+#include "basis/headers/TaskScheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <queue>
+
+using namespace GraphType;
+
+const long long DistanceTable::unreachable;
+
+DistanceTable::DistanceTable(const CompactGraph &graph, const Options &options) :
+        _graph(graph),
+        _options(options) {
+    for (int arc = 0; arc < _graph.countArcs() && _unweighted; ++arc)
+        this->_unweighted = _graph.weight(arc) == 1;
+}
+
+DistanceTable::~DistanceTable() = default;
+
+void DistanceTable::compute(const std::vector<int> &sources, const std::vector<int> &targets,
+                            std::vector<long long> &distances, std::vector<std::vector<int>> *paths) {
+    if (_unweighted && paths == nullptr) {
+        // A node learns the distances from a batch at as many levels as they differ, which stays few
+        // only while the whole graph is few levels deep
+        std::vector<int> depth;
+        if (!sources.empty() && breadthFirst(sources[0], depth) <= 32) {
+            bitParallel(sources, targets, distances);
+            return;
+        }
+        auto columns = targets.size();
+        distances.assign(sources.size() * columns, unreachable);
+        TaskScheduler::parallelFor(0, static_cast<int>(sources.size()), [&](int from, int to) {
+            std::vector<int> depth;
+            for (int i = from; i < to; ++i) {
+                breadthFirst(sources[i], depth);
+                for (size_t j = 0; j < columns; ++j) {
+                    if (depth[targets[j]] >= 0)
+                        distances[i * columns + j] = depth[targets[j]];
+                }
+            }
+        });
+        return;
+    }
+    // A few searches cost less than preprocessing
+    if (!_hierarchy && std::min(sources.size(), targets.size()) < 32) {
+        dijkstra(sources, targets, distances, paths);
+        return;
+    }
+    if (!_hierarchy)
+        this->_hierarchy.reset(new ContractionHierarchy(_graph, _options.hierarchy));
+    // Every forward search scans the buckets of the whole core, one entry per target each
+    long long scans = static_cast<long long>(_hierarchy->coreSize()) * static_cast<long long>(targets.size());
+    if (scans > 4 * (static_cast<long long>(_graph.countArcs()) + _graph.countNodes()))
+        dijkstra(sources, targets, distances, paths);
+    else
+        _hierarchy->manyToMany(sources, targets, distances, paths);
+}
+
+void DistanceTable::bitParallel(const std::vector<int> &sources, const std::vector<int> &targets,
+                                std::vector<long long> &distances) const {
+    int n = _graph.countNodes();
+    auto columns = static_cast<int>(targets.size());
+    distances.assign(sources.size() * targets.size(), unreachable);
+    if (n == 0 || columns == 0)
+        return;
+    // Which columns every node is the target of
+    std::vector<int> offsets(n + 1, 0), wanted(columns);
+    for (int target: targets)
+        ++offsets[target + 1];
+    for (int v = 0; v < n; ++v)
+        offsets[v + 1] += offsets[v];
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (int j = 0; j < columns; ++j)
+        wanted[fill[targets[j]]++] = j;
+
+    // Batches of 64 sources run in parallel, bit i of a node's word standing for the i-th source of the batch
+    auto batches = static_cast<int>((sources.size() + 63) / 64);
+    TaskScheduler::parallelFor(0, batches, [&](int from, int to) {
+        std::vector<Word> seen(n, 0), reached(n, 0), next(n, 0);
+        std::vector<int> frontier, following, touched;
+        for (int batch = from; batch < to; ++batch) {
+            auto first = static_cast<size_t>(batch) * 64;
+            auto size = static_cast<int>(std::min<size_t>(64, sources.size() - first));
+            for (int i = 0; i < size; ++i) {
+                int s = sources[first + i];
+                if (seen[s] == 0) {
+                    frontier.push_back(s);
+                    touched.push_back(s);
+                }
+                seen[s] |= Word(1) << i;
+                reached[s] = seen[s];
+            }
+            for (long long level = 0; !frontier.empty(); ++level) {
+                AlgorithmContext::step(static_cast<long long>(frontier.size()));
+                for (int v: frontier) {
+                    for (int k = offsets[v]; k < offsets[v + 1]; ++k) {
+                        for (int i = 0; i < size; ++i) {
+                            if ((reached[v] >> i) & 1)
+                                distances[(first + i) * columns + wanted[k]] = level;
+                        }
+                    }
+                }
+                // Only the bits a node got at this level travel on
+                for (int u: frontier) {
+                    for (int arc = _graph.arcBegin(u); arc < _graph.arcEnd(u); ++arc) {
+                        int v = _graph.target(arc);
+                        Word bits = reached[u] & ~seen[v];
+                        if (bits == 0)
+                            continue;
+                        if (seen[v] == 0)
+                            touched.push_back(v);
+                        if (next[v] == 0)
+                            following.push_back(v);
+                        seen[v] |= bits;
+                        next[v] |= bits;
+                    }
+                }
+                for (int v: frontier)
+                    reached[v] = 0;
+                for (int v: following) {
+                    reached[v] = next[v];
+                    next[v] = 0;
+                }
+                frontier.swap(following);
+                following.clear();
+            }
+            for (int v: touched)
+                seen[v] = 0;
+            touched.clear();
+        }
+    }, 1);
+}
+
+int DistanceTable::breadthFirst(int source, std::vector<int> &depth) const {
+    depth.assign(_graph.countNodes(), -1);
+    std::vector<int> queue{source};
+    depth[source] = 0;
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int u = queue[head];
+        AlgorithmContext::step();
+        for (int arc = _graph.arcBegin(u); arc < _graph.arcEnd(u); ++arc) {
+            if (depth[_graph.target(arc)] < 0) {
+                depth[_graph.target(arc)] = depth[u] + 1;
+                queue.push_back(_graph.target(arc));
+            }
+        }
+    }
+    return depth[queue.back()] + 1;
+}
+
+void DistanceTable::dijkstra(const std::vector<int> &sources, const std::vector<int> &targets,
+                             std::vector<long long> &distances, std::vector<std::vector<int>> *paths) const {
+    int n = _graph.countNodes();
+    auto columns = static_cast<int>(targets.size());
+    distances.assign(sources.size() * targets.size(), unreachable);
+    if (paths != nullptr)
+        paths->assign(distances.size(), std::vector<int>());
+    TaskScheduler::parallelFor(0, static_cast<int>(sources.size()), [&](int from, int to) {
+        std::vector<long long> distance(n);
+        std::vector<int> parent(n);
+        typedef std::pair<long long, int> Item;
+        for (int i = from; i < to; ++i) {
+            std::fill(distance.begin(), distance.end(), unreachable);
+            std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+            distance[sources[i]] = 0;
+            parent[sources[i]] = -1;
+            queue.emplace(0, sources[i]);
+            while (!queue.empty()) {
+                auto item = queue.top();
+                queue.pop();
+                int u = item.second;
+                if (item.first > distance[u])
+                    continue;
+                AlgorithmContext::step();
+                for (int arc = _graph.arcBegin(u); arc < _graph.arcEnd(u); ++arc) {
+                    int v = _graph.target(arc);
+                    if (item.first + _graph.weight(arc) < distance[v]) {
+                        distance[v] = item.first + _graph.weight(arc);
+                        parent[v] = u;
+                        queue.emplace(distance[v], v);
+                    }
+                }
+            }
+            for (int j = 0; j < columns; ++j) {
+                size_t cell = static_cast<size_t>(i) * columns + j;
+                distances[cell] = distance[targets[j]];
+                if (paths == nullptr || distance[targets[j]] == unreachable)
+                    continue;
+                auto &path = (*paths)[cell];
+                for (int v = targets[j]; v >= 0; v = parent[v])
+                    path.push_back(v);
+                std::reverse(path.begin(), path.end());
+            }
+        }
+    });
+}
@@ -0,0 +1,195 @@
+#include "basis/headers/ForceLayout.h"
+#include "basis/headers/TaskScheduler.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace GraphType;
+
+ForceLayout::ForceLayout(const CompactGraph &graph, std::vector<double> x, std::vector<double> y,
+                         const Options &options) :
+        _graph(graph),
+        _options(options),
+        _x(std::move(x)),
+        _y(std::move(y)) {
+    int n = _graph.countNodes();
+    _dx.resize(n);
+    _dy.resize(n);
+    _next.resize(n);
+    _order.resize(n);
+    for (int i = 0; i < n; ++i)
+        _order[i] = i;
+    double k = _options.idealLength;
+    this->_temperature = _options.temperature > 0 ? _options.temperature
+                                                  : std::max(k, k * std::sqrt(static_cast<double>(n)) / 4);
+    this->_cooling = std::pow(std::min(1., k / 20 / _temperature), 1. / std::max(1, _options.iterations));
+}
+
+void ForceLayout::fit(std::vector<double> &x, std::vector<double> &y, double idealLength) {
+    if (x.empty())
+        return;
+    auto xs = std::minmax_element(x.begin(), x.end());
+    auto ys = std::minmax_element(y.begin(), y.end());
+    double span = std::max(*xs.second - *xs.first, *ys.second - *ys.first);
+    double cx = (*xs.first + *xs.second) / 2, cy = (*ys.first + *ys.second) / 2;
+    auto n = static_cast<double>(x.size());
+    double side = idealLength * std::sqrt(n);
+    if (span < 1e-9) {
+        for (size_t i = 0; i < x.size(); ++i) {
+            double r = side / 2 * std::sqrt(i / n);
+            x[i] = cx + r * std::cos(i * 2.39996);
+            y[i] = cy + r * std::sin(i * 2.39996);
+        }
+        return;
+    }
+    double scale = side / span;
+    for (size_t i = 0; i < x.size(); ++i) {
+        x[i] = cx + (x[i] - cx) * scale;
+        y[i] = cy + (y[i] - cy) * scale;
+    }
+}
+
+void ForceLayout::buildTree() {
+    _cells.clear();
+    int n = _graph.countNodes();
+    if (n == 0)
+        return;
+    auto xs = std::minmax_element(_x.begin(), _x.end());
+    auto ys = std::minmax_element(_y.begin(), _y.end());
+    double half = std::max(*xs.second - *xs.first, *ys.second - *ys.first) / 2 + 1;
+    _cells.emplace_back((*xs.first + *xs.second) / 2, (*ys.first + *ys.second) / 2, half);
+    for (int body: _order)
+        insert(body);
+    for (auto &cell: _cells) {
+        if (cell.mass > 0) {
+            cell.mx /= cell.mass;
+            cell.my /= cell.mass;
+        }
+    }
+}
+
+void ForceLayout::insert(int body) {
+    double x = _x[body], y = _y[body];
+    int c = 0;
+    for (int depth = 0;; ++depth) {
+        _cells[c].mass += 1;
+        _cells[c].mx += x;
+        _cells[c].my += y;
+        if (_cells[c].child < 0) {
+            // Bodies piled up on one spot share a leaf, it then acts as their center of mass
+            if (_cells[c].mass == 1 || _cells[c].mass > 2 || depth >= _maxDepth) {
+                _next[body] = _cells[c].body;
+                _cells[c].body = body;
+                return;
+            }
+            int old = _cells[c].body;
+            double h = _cells[c].half / 2, cx = _cells[c].cx, cy = _cells[c].cy;
+            int first = static_cast<int>(_cells.size());
+            _cells.emplace_back(cx - h, cy - h, h);
+            _cells.emplace_back(cx + h, cy - h, h);
+            _cells.emplace_back(cx - h, cy + h, h);
+            _cells.emplace_back(cx + h, cy + h, h);
+            _cells[c].child = first;
+            _cells[c].body = -1;
+            auto &moved = _cells[first + (_x[old] >= cx ? 1 : 0) + (_y[old] >= cy ? 2 : 0)];
+            moved.mass = 1;
+            moved.mx = _x[old];
+            moved.my = _y[old];
+            moved.body = old;
+        }
+        c = _cells[c].child + (x >= _cells[c].cx ? 1 : 0) + (y >= _cells[c].cy ? 2 : 0);
+    }
+}
+
+void ForceLayout::collectOrder() {
+    // Visiting bodies leaf by leaf keeps neighbouring bodies, and the cells they touch, close in memory
+    _order.clear();
+    std::vector<int> stack{0};
+    while (!stack.empty()) {
+        int c = stack.back();
+        stack.pop_back();
+        if (_cells[c].child < 0) {
+            for (int body = _cells[c].body; body >= 0; body = _next[body])
+                _order.push_back(body);
+            continue;
+        }
+        for (int i = 3; i >= 0; --i)
+            stack.push_back(_cells[c].child + i);
+    }
+}
+
+void ForceLayout::repulse(int body) {
+    double k2 = _options.idealLength * _options.idealLength;
+    double theta2 = _options.theta * _options.theta;
+    double x = _x[body], y = _y[body], fx = 0, fy = 0;
+    int stack[_maxDepth * 4 + 8];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Cell &cell = _cells[stack[--top]];
+        if (cell.mass == 0 || (cell.mass == 1 && cell.body == body))
+            continue;
+        double dx = x - cell.mx, dy = y - cell.my;
+        double d2 = dx * dx + dy * dy;
+        if (cell.child < 0 || 4 * cell.half * cell.half < theta2 * d2) {
+            if (d2 < 1e-6) {
+                // Separate coincident bodies in a direction that depends on the body only
+                dx = std::cos(body * 2.39996);
+                dy = std::sin(body * 2.39996);
+                d2 = 1;
+            }
+            fx += dx * k2 * cell.mass / d2;
+            fy += dy * k2 * cell.mass / d2;
+            continue;
+        }
+        for (int i = 0; i < 4; ++i)
+            stack[top++] = cell.child + i;
+    }
+    _dx[body] = fx;
+    _dy[body] = fy;
+}
+
+bool ForceLayout::step() {
+    int n = _graph.countNodes();
+    if (n == 0 || _iteration >= _options.iterations)
+        return false;
+    buildTree();
+    collectOrder();
+    double k = _options.idealLength;
+    double cx = _cells[0].mx, cy = _cells[0].my;
+    double maxMove = 0;
+    std::vector<double> moves(n);
+    TaskScheduler::parallelFor(0, n, [&](int from, int to) {
+        for (int index = from; index < to; ++index) {
+            int i = _order[index];
+            repulse(i);
+            // Attraction d^2 / k along every edge, each end pulls only itself
+            for (int arc = _graph.arcBegin(i); arc < _graph.arcEnd(i); ++arc) {
+                int j = _graph.target(arc);
+                double dx = _x[i] - _x[j], dy = _y[i] - _y[j];
+                double d = std::sqrt(dx * dx + dy * dy);
+                _dx[i] -= dx * d / k;
+                _dy[i] -= dy * d / k;
+            }
+            _dx[i] -= (_x[i] - cx) * _options.gravity;
+            _dy[i] -= (_y[i] - cy) * _options.gravity;
+        }
+    }, 64);
+    TaskScheduler::parallelFor(0, n, [&](int from, int to) {
+        for (int i = from; i < to; ++i) {
+            double length = std::sqrt(_dx[i] * _dx[i] + _dy[i] * _dy[i]);
+            if (length <= 0) {
+                moves[i] = 0;
+                continue;
+            }
+            double move = std::min(length, _temperature);
+            _x[i] += _dx[i] / length * move;
+            _y[i] += _dy[i] / length * move;
+            moves[i] = move;
+        }
+    }, 2048);
+    for (double move: moves)
+        maxMove = std::max(maxMove, move);
+    this->_temperature *= _cooling;
+    ++_iteration;
+    return maxMove > k * 0.002;
+}
@@ -2,6 +2,7 @@
 #include <iomanip>
 #include <cmath>
 #include <algorithm>
+#include <sstream>
 #include "utils/random.h"
 
 using namespace GraphType;
@@ -19,7 +20,7 @@ void Graph::_init(int node_num) {
     if (node_num <= 0) return;
     Random random;
     for (int i = 0; i < node_num; ++i) {
-        QPointF point((1 - sin((i * 6.28) / node_num)) * node_num * 80 / 2.,
+        Point point((1 - sin((i * 6.28) / node_num)) * node_num * 80 / 2.,
                       (1 - cos((i * 6.28) / node_num)) * node_num * 80 / 2.);
         addNode(Node(nextNodeName(), point));
     }
@@ -32,16 +33,133 @@ Graph::Graph(const Graph &obj) :
         _weightRange(obj._weightRange) {
     this->clear();
     for (auto &node: obj.nodeList())
-        this->addNode(node->name());
+        this->addNode(Node(node->name(), node->euclidePos()));
     for (auto it = obj.edgeSet().begin(); it != obj.edgeSet().end(); ++it) {
         this->setEdge(Edge(it).u()->name(), Edge(it).v()->name(), Edge(it).weight());
     }
 }
 
+Graph::Graph(const GraphSnapshot &snapshot) :
+        _directed(snapshot.isDirected()),
+        _weighted(snapshot.isWeighted()),
+        _invalidValue(_calcInvalid(snapshot.isDirected(), snapshot.isWeighted())),
+        _weightRange(_calcWeightRange(snapshot.isWeighted())) {
+    this->clear();
+    std::vector<Node *> nodes(snapshot.nodeCapacity(), nullptr);
+    for (int id: snapshot.nodeIds()) {
+        const auto &record = snapshot.node(id);
+        addNode(Node(record.name, record.pos));
+        nodes[id] = node(record.name);
+    }
+    for (int id = 0; id < snapshot.edgeCapacity(); ++id) {
+        if (snapshot.hasEdge(id))
+            setEdge(nodes[snapshot.edge(id).u], nodes[snapshot.edge(id).v], snapshot.edge(id).weight);
+    }
+}
+
 void Graph::clear() {
     this->_nodeSet.clear();
     this->_edgeSet.clear();
     this->_cachedNodeList.clear();
+    _clearTables(true);
+    _record(GraphEvent::Cleared);
+}
+
+void Graph::clearEdges() {
+    this->_edgeSet.clear();
+    for (auto node: _cachedNodeList)
+        node->resetDegree();
+    _clearTables(false);
+    _record(GraphEvent::Cleared);
+}
+
+GraphSnapshot Graph::snapshot() const {
+    GraphSnapshot snapshot = _tables;
+    snapshot._directed = _directed;
+    snapshot._weighted = _weighted;
+    snapshot._version = _version;
+    snapshot._countNodes = countNodes();
+    snapshot._countEdges = countEdges();
+    return snapshot;
+}
+
+void Graph::_storeNode(Node *node) {
+    int id;
+    if (_freeNodeIds.empty()) {
+        id = _tables._nodes.size();
+        _tables._nodes.push_back(NodeRecord());
+    } else {
+        id = _freeNodeIds.back();
+        _freeNodeIds.pop_back();
+    }
+    node->_id = id;
+    auto &record = _tables._nodes.mutableAt(id);
+    record.name = node->name();
+    record.pos = node->euclidePos();
+    record.alive = true;
+    record.sequence = ++_nodesAdded;
+}
+
+void Graph::_dropNode(Node *node) {
+    _tables._nodes.mutableAt(node->_id) = NodeRecord();
+    _freeNodeIds.push_back(node->_id);
+}
+
+void Graph::_storeEdge(const NodePair &pair, int w) {
+    auto it = _edgeIds.find(pair);
+    int id;
+    if (it != _edgeIds.end()) {
+        id = it->second;
+    } else if (_freeEdgeIds.empty()) {
+        id = _tables._edges.size();
+        _tables._edges.push_back(EdgeRecord());
+    } else {
+        id = _freeEdgeIds.back();
+        _freeEdgeIds.pop_back();
+    }
+    _edgeIds[pair] = id;
+    auto &record = _tables._edges.mutableAt(id);
+    record.u = pair.first->_id;
+    record.v = pair.second->_id;
+    record.weight = w;
+}
+
+void Graph::_dropEdge(const NodePair &pair) {
+    auto it = _edgeIds.find(pair);
+    _tables._edges.mutableAt(it->second) = EdgeRecord();
+    _freeEdgeIds.push_back(it->second);
+    _edgeIds.erase(it);
+}
+
+void Graph::_clearTables(bool nodes) {
+    if (nodes) {
+        _tables._nodes.clear();
+        _freeNodeIds.clear();
+    }
+    _tables._edges.clear();
+    _freeEdgeIds.clear();
+    _edgeIds.clear();
+}
+
+void Graph::_record(GraphEvent::Type type, const std::string &u, const std::string &v, int w) {
+    ++_version;
+    // Nothing is journaled until somebody listens
+    if (!_changeHandler) return;
+    bool first = _events.empty();
+    _events.push_back({type, u, v, w, _version});
+    if (first)
+        _changeHandler();
+}
+
+void Graph::setChangeHandler(std::function<void()> handler) {
+    this->_changeHandler = std::move(handler);
+    this->_events.clear();
+}
+
+std::vector<GraphEvent> Graph::takeEvents() {
+    std::vector<GraphEvent> events;
+    events.swap(_events);
+    return events;
 }
 
 Graph Graph::readFromFile(const std::string &file) {
@@ -56,10 +174,10 @@ Graph Graph::readFromFile(const std::string &file) {
     in >> countNodes;
     if (countNodes <= 0) throw "Number of nodes <= 0";
     std::string name;
-    qreal x, y;
+    double x, y;
     for (int i = 0; i < countNodes; ++i) {
         if (in.eof()) throw "eof";
-        in >> name >> x >> y, graph.addNode(Node(name, QPointF(x, y)));
+        in >> name >> x >> y, graph.addNode(Node(name, Point(x, y)));
     }
     int countEdges;
     in >> countEdges;
@@ -79,6 +197,46 @@ Graph Graph::readFromFile(const std::string &file) {
     return graph;
 }
 
+Graph Graph::readEdgeList(const std::string &file, bool directed) {
+    std::ifstream in(file);
+    if (!in) throw "file not existed";
+
+    struct Line {
+        std::string u, v;
+        int weight;
+    };
+    std::vector<Line> lines;
+    bool weighted = false;
+    std::string text;
+    while (std::getline(in, text)) {
+        std::istringstream fields(text);
+        Line line{"", "", 1};
+        if (!(fields >> line.u) || line.u[0] == '#' || line.u[0] == '%')
+            continue;
+        if (!(fields >> line.v)) throw "Edge without its second node";
+        std::string weight;
+        if (fields >> weight) {
+            // The whole column is the weight, "1.5" or "x" is an error rather than 1 or no weight
+            std::istringstream number(weight);
+            if (!(number >> line.weight) || number.peek() != std::char_traits<char>::eof())
+                throw "Invalid weight value";
+            weighted = true;
+        }
+        lines.push_back(line);
+    }
+    Graph graph(directed, weighted);
+    for (const auto &line: lines) {
+        if (line.weight < graph.weightRange().first || line.weight > graph.weightRange().second)
+            throw "Invalid weight value";
+        if (!graph.hasNode(line.u))
+            graph.addNode(line.u);
+        if (!graph.hasNode(line.v))
+            graph.addNode(line.v);
+        graph.setEdge(line.u, line.v, line.weight);
+    }
+    return graph;
+}
+
 void Graph::writeToFile(const std::string &file, const Graph &graph) {
     std::ofstream out;
     out.open(file, std::ofstream::out | std::ofstream::trunc);
@@ -86,6 +244,13 @@ void Graph::writeToFile(const std::string &file, const Graph &graph) {
     out.close();
 }
 
+void Graph::writeToFile(const std::string &file, const GraphSnapshot &snapshot) {
+    std::ofstream out;
+    out.open(file, std::ofstream::out | std::ofstream::trunc);
+    out << snapshot;
+    out.close();
+}
+
 Node *Graph::node(const std::string &node_name) const {
     if (!hasNode(node_name))
         return nullptr;
@@ -96,6 +261,8 @@ bool Graph::addNode(const Node &_node) {
     if (hasNode(_node.name())) return false;
     _nodeSet.insert(_node);
     _cachedNodeList.emplace_back(node(_node.name()));
+    _storeNode(_cachedNodeList.back());
+    _record(GraphEvent::NodeAdded, _node.name());
     return true;
 }
 
@@ -118,8 +285,11 @@ bool Graph::removeNode(Node *node) {
     if (!hasNode(node))
         return false;
     isolateNode(node);
-    _nodeSet.erase(*node);
+    auto name = node->name();
     _cachedNodeList.remove(node);
+    _dropNode(node);
+    _nodeSet.erase(_nodeSet.find(*node));
+    _record(GraphEvent::NodeRemoved, name);
     return true;
 }
 
@@ -169,6 +339,14 @@ bool Graph::setNodeName(const std::string &old_name, const std::string &new_name
     return setNodeName(node(old_name), new_name);
 }
 
+bool Graph::setNodePos(Node *node, const Point &pos) {
+    if (!hasNode(node))
+        return false;
+    node->setEuclidePos(pos);
+    _tables._nodes.mutableAt(node->_id).pos = pos;
+    return true;
+}
+
 int Graph::weight(Node *u, Node *v) const {
     if (u == v)
         return 0;
@@ -189,12 +367,15 @@ bool Graph::setEdge(Node *u, Node *v, int w) {
         || w < _weightRange.first || w > _weightRange.second)
         return false;
 
-    if (hasDirectedEdge(u, v))
+    if (hasDirectedEdge(u, v)) {
         _edgeSet.at({u, v}) = w;
-    else if (!_directed && hasDirectedEdge(v, u))
+        _storeEdge({u, v}, w);
+    } else if (!_directed && hasDirectedEdge(v, u)) {
         _edgeSet.at({v, u}) = w;
-    else {
+        _storeEdge({v, u}, w);
+    } else {
         _edgeSet.insert({{u, v}, w});
+        _storeEdge({u, v}, w);
         if (_directed) {
             u->incNegDegree();
             v->incPosDegree();
@@ -203,6 +384,7 @@ bool Graph::setEdge(Node *u, Node *v, int w) {
             v->incUndirDegree();
         }
     }
+    _record(GraphEvent::EdgeSet, u->name(), v->name(), w);
     return true;
 }
 
@@ -219,6 +401,7 @@ bool Graph::removeEdge(Node *u, Node *v) {
         return false;
     if (hasDirectedEdge(u, v)) {
         _edgeSet.erase({u, v});
+        _dropEdge({u, v});
         if (_directed) {
             u->decNegDegree();
             v->decPosDegree();
@@ -226,11 +409,15 @@ bool Graph::removeEdge(Node *u, Node *v) {
             u->decUndirDegree();
             v->decUndirDegree();
         }
+        _record(GraphEvent::EdgeRemoved, u->name(), v->name());
         return true;
     } else if (!_directed && hasDirectedEdge(v, u)) {
         _edgeSet.erase({v, u});
+        _dropEdge({v, u});
         u->decUndirDegree();
         v->decUndirDegree();
+        _record(GraphEvent::EdgeRemoved, u->name(), v->name());
+        return true;
     }
     return false;
 }
@@ -279,7 +466,32 @@ bool Graph::hasEdge(const std::string &uname, const std::string &vname) const {
     return hasEdge(node(uname), node(vname));
 }
 
+std::vector<int> GraphSnapshot::nodeIds() const {
+    std::vector<int> ids;
+    ids.reserve(_countNodes);
+    for (int id = 0; id < nodeCapacity(); ++id)
+        if (hasNode(id))
+            ids.push_back(id);
+    std::sort(ids.begin(), ids.end(), [this](int a, int b) { return _nodes[a].sequence < _nodes[b].sequence; });
+    return ids;
+}
+
 namespace GraphType {
+    std::ostream &operator<<(std::ostream &out, const GraphSnapshot &snapshot) {
+        out << snapshot.isDirected() << " " << snapshot.isWeighted() << "\n";
+        out << snapshot.countNodes() << "\n";
+        for (int id: snapshot.nodeIds())
+            out << snapshot.node(id).name << " " << snapshot.node(id).pos.x() << " " << snapshot.node(id).pos.y() << "\n";
+        out << snapshot.countEdges() << "\n";
+        for (int id = 0; id < snapshot.edgeCapacity(); ++id) {
+            if (!snapshot.hasEdge(id))
+                continue;
+            const auto &edge = snapshot.edge(id);
+            out << snapshot.node(edge.u).name << " " << snapshot.node(edge.v).name << " " << edge.weight << "\n";
+        }
+        return out;
+    }
+
     std::ostream &operator<<(std::ostream &out, const Graph &graph) {
         out << graph.isDirected() << " " << graph.isWeighted() << "\n";
         out << graph.countNodes() << "\n";
@@ -1,32 +1,54 @@
 #include "basis/headers/GraphUtils.h"
+#include "basis/headers/AlgorithmContext.h"
+#include "basis/headers/TaskScheduler.h"
+#include "basis/headers/CompactGraph.h"
+#include "basis/headers/ParallelBFS.h"
+#include "basis/headers/DeltaStepping.h"
+#include "basis/headers/DistanceTable.h"
+#include <algorithm>
+#include <atomic>
+#include <map>
 #include <unordered_map>
 #include <utility>
-#include <QString>
-#include <QDebug>
 
-std::list<std::pair<std::string, std::string>> GraphUtils::BFSToDemo(const Graph *graph, const std::string &source) {
-    std::list<std::pair<std::string, std::string>> result;
-    if (!graph->hasNode(source)) return result;
+NodePairSequence nodePairs(const Graph *graph, const std::list<std::pair<std::string, std::string>> &pairs) {
+    NodePairSequence result(graph);
+    for (const auto &pair: pairs)
+        result.push_back(graph->node(pair.first), graph->node(pair.second));
+    return result;
+}
 
-    auto nodes = graph->nodeList();
-    std::queue<std::string> q;
-    std::unordered_map<std::string, bool> visited;
-    std::unordered_map<std::string, std::string> parent;
-    q.push(source);
-    visited[source] = true;
+NodePairSequence GraphUtils::BFSToDemo(const Graph *graph, const std::string &source) {
+    return BFSToDemo(graph->snapshot(), source);
+}
+
+NodePairSequence GraphUtils::BFSToDemo(const GraphSnapshot &graph, const std::string &source) {
+    NodePairSequence result(graph);
+    CompactGraph compact(graph);
+    int root = compact.fromSnapshotId(result.find(source));
+    if (root < 0) return result;
+
+    auto targets = compact.sortedTargets();
+    std::vector<bool> visited(compact.countNodes(), false);
+    std::vector<int> parent(compact.countNodes(), -1);
+    std::queue<int> q;
+    q.push(root);
+    visited[root] = true;
     std::cout << "Обход в ширину (начальная вершина = " << source << "): ";
 
     while (!q.empty()) {
-        auto vname = q.front();
-        std::cout << vname << " ";
-        result.emplace_back(parent[vname], vname);
+        int u = q.front();
+        AlgorithmContext::step();
+        result.push_back(parent[u] >= 0 ? compact.snapshotId(parent[u]) : -1, compact.snapshotId(u));
+        std::cout << result.name(result.to(result.size() - 1)) << " ";
         q.pop();
 
-        for (auto &adj : nodes) {
-            if (graph->hasEdge(vname, adj->name()) && !visited[adj->name()]) {
-                visited[adj->name()] = true;
-                q.push(adj->name());
-                parent[adj->name()] = vname;
+        for (int arc = compact.arcBegin(u); arc < compact.arcEnd(u); ++arc) {
+            int v = targets[arc];
+            if (!visited[v]) {
+                visited[v] = true;
+                q.push(v);
+                parent[v] = u;
             }
         }
     }
@@ -34,29 +56,67 @@ std::list<std::pair<std::string, std::string>> GraphUtils::BFSToDemo(const Graph
     return result;
 }
 
-std::list<std::pair<std::string, std::string>> GraphUtils::DFSToDemo(const Graph *graph, const std::string &source) {
-    std::list<std::pair<std::string, std::string>> result;
-    if (!graph->hasNode(source)) return result;
+NodePairSequence GraphUtils::BFSTree(const Graph *graph, const std::string &source) {
+    return BFSTree(graph->snapshot(), source);
+}
 
-    auto nodes = graph->nodeList();
-    std::stack<std::string> s;
-    std::unordered_map<std::string, bool> visited;
-    std::unordered_map<std::string, std::string> parent;
-    s.push(source);
-    visited[source] = true;
+NodePairSequence GraphUtils::BFSTree(const GraphSnapshot &graph, const std::string &source) {
+    NodePairSequence result(graph);
+    CompactGraph compact(graph);
+    int root = compact.fromSnapshotId(result.find(source));
+    if (root < 0) return result;
+
+    ParallelBFS bfs(compact, ParallelBFS::Options());
+    std::vector<int> depth, parent;
+    bfs.run(root, depth, parent);
+    std::vector<std::vector<int>> levels;
+    for (int v = 0; v < compact.countNodes(); ++v) {
+        if (depth[v] < 0)
+            continue;
+        if (depth[v] >= static_cast<int>(levels.size()))
+            levels.resize(depth[v] + 1);
+        levels[depth[v]].push_back(v);
+    }
+    for (const auto &level: levels) {
+        for (int v: level)
+            result.push_back(v == parent[v] ? -1 : compact.snapshotId(parent[v]), compact.snapshotId(v));
+    }
+    std::cout << "Обход в ширину (начальная вершина = " << source << "): "
+              << result.size() << " вершин, " << levels.size() << " уровней\n";
+    return result;
+}
+
+NodePairSequence GraphUtils::DFSToDemo(const Graph *graph, const std::string &source) {
+    return DFSToDemo(graph->snapshot(), source);
+}
+
+NodePairSequence GraphUtils::DFSToDemo(const GraphSnapshot &graph, const std::string &source) {
+    NodePairSequence result(graph);
+    CompactGraph compact(graph);
+    int root = compact.fromSnapshotId(result.find(source));
+    if (root < 0) return result;
+
+    auto targets = compact.sortedTargets();
+    std::vector<bool> visited(compact.countNodes(), false);
+    std::vector<int> parent(compact.countNodes(), -1);
+    std::stack<int> s;
+    s.push(root);
+    visited[root] = true;
 
     std::cout << "Поиск в глубину (начальная вершина = " << source << "): ";
     while (!s.empty()) {
-        auto vname = s.top();
-        std::cout << vname << " ";
-        visited[vname] = true;
-        result.emplace_back(parent[vname], vname);
+        int u = s.top();
+        AlgorithmContext::step();
+        visited[u] = true;
+        result.push_back(parent[u] >= 0 ? compact.snapshotId(parent[u]) : -1, compact.snapshotId(u));
+        std::cout << result.name(result.to(result.size() - 1)) << " ";
         s.pop();
 
-        for (auto &adj: nodes) {
-            if (graph->hasEdge(vname, adj->name()) && !visited[adj->name()]) {
-                s.push(adj->name());
-                parent[adj->name()] = vname;
+        for (int arc = compact.arcBegin(u); arc < compact.arcEnd(u); ++arc) {
+            int v = targets[arc];
+            if (!visited[v]) {
+                s.push(v);
+                parent[v] = u;
             }
         }
     }
@@ -64,32 +124,35 @@ std::list<std::pair<std::string, std::string>> GraphUtils::DFSToDemo(const Graph
     return result;
 }
 
-std::list<std::string> GraphUtils::BFS(const Graph *graph, std::string source) {
-    auto nodes = graph->nodeList();
-    if (source.empty())
-        source = nodes.front()->name();
-    std::list<std::string> steps;
-    if (!graph->hasNode(source)) return steps;
-    std::queue<std::string> q;
-    std::unordered_map<std::string, bool> visited;
-    q.push(source);
-    visited[source] = true;
-    while (!q.empty()) {
-        auto vname = q.front();
-        steps.push_back(vname);
-        q.pop();
-        for (auto &adj: nodes) {
-            if (graph->hasEdge(vname, adj->name()) && !visited[adj->name()]) {
-                visited[adj->name()] = true;
-                q.push(adj->name());
+NodeSequence GraphUtils::BFS(const Graph *graph, std::string source) {
+    NodeSequence steps(graph);
+    auto root = source.empty() ? (graph->countNodes() > 0 ? graph->nodeList().front() : nullptr) : graph->node(source);
+    if (root == nullptr) return steps;
+    CompactGraph compact(*graph);
+    auto targets = compact.sortedTargets();
+    std::vector<bool> visited(compact.countNodes(), false);
+    // The queue is the order itself
+    std::vector<int> order{compact.id(root)};
+    visited[order.front()] = true;
+    for (size_t head = 0; head < order.size(); ++head) {
+        int u = order[head];
+        AlgorithmContext::step();
+        for (int arc = compact.arcBegin(u); arc < compact.arcEnd(u); ++arc) {
+            if (!visited[targets[arc]]) {
+                visited[targets[arc]] = true;
+                order.push_back(targets[arc]);
             }
         }
     }
+    steps.reserve(order.size());
+    for (int v: order)
+        steps.push_back(compact.node(v));
     return steps;
 }
 
 void GraphUtils::DFSUtil(const Graph *graph, const std::string &vname, std::unordered_map<std::string, bool> &visited,
                          std::list<std::string> &steps) {
+    AlgorithmContext::step();
     visited[vname] = true;
     steps.push_back(vname);
     for (auto &adj: graph->nodeList()) {
@@ -100,6 +163,7 @@ void GraphUtils::DFSUtil(const Graph *graph, const std::string &vname, std::unor
 
 void UndirectedDFSUtil(const Graph *graph, const std::string &vname, std::unordered_map<std::string, bool> &visited,
                        std::list<std::string> &steps) {
+    AlgorithmContext::step();
     visited[vname] = true;
     steps.push_back(vname);
     for (auto &adj: graph->nodeList()) {
@@ -109,6 +173,7 @@ void UndirectedDFSUtil(const Graph *graph, const std::string &vname, std::unorde
 }
 
 int DFSCount(const Graph &graph, const std::string &uname, std::unordered_map<std::string, bool> &visited) {
+    AlgorithmContext::step();
     visited[uname] = true;
     int count = 1;
     for (auto v: graph.nodeList())
@@ -117,14 +182,31 @@ int DFSCount(const Graph &graph, const std::string &uname, std::unordered_map<st
     return count;
 }
 
-std::list<std::string> GraphUtils::DFS(const Graph *graph, std::string source) {
-    auto nodes = graph->nodeList();
-    if (source.empty())
-        source = nodes.front()->name();
-    std::list<std::string> steps;
-    std::unordered_map<std::string, bool> visited;
-    if (!graph->hasNode(source)) return steps;
-    DFSUtil(graph, source, visited, steps);
+NodeSequence GraphUtils::DFS(const Graph *graph, std::string source) {
+    NodeSequence steps(graph);
+    auto root = source.empty() ? (graph->countNodes() > 0 ? graph->nodeList().front() : nullptr) : graph->node(source);
+    if (root == nullptr) return steps;
+    CompactGraph compact(*graph);
+    auto targets = compact.sortedTargets();
+    std::vector<bool> visited(compact.countNodes(), false);
+    // Preorder as DFSUtil recurses, a frame is a node and its next arc
+    std::vector<std::pair<int, int>> stack{{compact.id(root), compact.arcBegin(compact.id(root))}};
+    visited[stack.back().first] = true;
+    steps.push_back(root);
+    while (!stack.empty()) {
+        auto &frame = stack.back();
+        if (frame.second == compact.arcEnd(frame.first)) {
+            stack.pop_back();
+            continue;
+        }
+        int v = targets[frame.second++];
+        if (visited[v])
+            continue;
+        AlgorithmContext::step();
+        visited[v] = true;
+        steps.push_back(compact.node(v));
+        stack.emplace_back(v, compact.arcBegin(v));
+    }
     return steps;
 }
 
@@ -137,21 +219,26 @@ bool GraphUtils::isConnectedFromUtoV(const Graph *graph, const std::string &unam
 }
 
 bool GraphUtils::isAllConnected(const Graph *graph) {
-    auto nodes = graph->nodeList();
-    for (auto &node: nodes) {
-        std::unordered_map<std::string, bool> visited;
-        std::list<std::string> steps;
-        DFSUtil(graph, node->name(), visited, steps);
-        for (auto &v: nodes) {
-            if (!visited[v->name()])
-                return false;
+    auto list = graph->nodeList();
+    std::vector<Node *> nodes(list.begin(), list.end());
+    // One search per source, the first that misses a node settles it for all
+    std::atomic<bool> connected{true};
+    TaskScheduler::parallelFor(0, static_cast<int>(nodes.size()), [&](int from, int to) {
+        for (int i = from; i < to && connected; ++i) {
+            std::unordered_map<std::string, bool> visited;
+            std::list<std::string> steps;
+            DFSUtil(graph, nodes[i]->name(), visited, steps);
+            if (static_cast<int>(steps.size()) < graph->countNodes())
+                connected = false;
         }
-    }
-    return true;
+    });
+    return connected;
 }
 
 bool GraphUtils::isAllWeaklyConnected(const Graph *graph) {
     auto nodes = graph->nodeList();
+    if (nodes.empty())
+        return true;
     std::queue<std::string> q;
     std::unordered_map<std::string, bool> visited;
     q.push(nodes.front()->name());
@@ -160,6 +247,7 @@ bool GraphUtils::isAllWeaklyConnected(const Graph *graph) {
     while (!q.empty()) {
         auto vname = q.front();
         q.pop();
+        AlgorithmContext::step();
         for (auto &adj: nodes) {
             if ((graph->hasEdge(vname, adj->name()) || graph->hasEdge(adj->name(), vname)) &&
                 !visited[adj->name()]) {
@@ -196,6 +284,7 @@ std::list<std::string> GraphUtils::Dijkstra(const Graph *graph, const std::strin
     std::unordered_map<std::string, std::string> parent;
     dist[start] = 0;
     for (int count = 0; count < graph->countNodes() - 1; count++) {
+        AlgorithmContext::step();
         auto uname = minDistance(dist, sptSet);
         sptSet[uname] = true;
         for (auto &v: nodes) {
@@ -223,9 +312,83 @@ std::list<std::string> GraphUtils::Dijkstra(const Graph *graph, const std::strin
     return path;
 }
 
+std::list<std::string> GraphUtils::DeltaSteppingPath(const Graph *graph, const std::string &start,
+                                                    const std::string &goal) {
+    std::list<std::string> path;
+    if (!graph->hasNode(start) || !graph->hasNode(goal))
+        return path;
+    CompactGraph compact(*graph);
+    GraphType::DeltaStepping search(compact, GraphType::DeltaStepping::Options());
+    std::vector<long long> distance;
+    std::vector<int> parent;
+    search.run(compact.id(graph->node(start)), distance, parent);
+    int target = compact.id(graph->node(goal));
+    std::cout << "Delta-stepping: shortest path from " << start << " to " << goal << ": ";
+    if (distance[target] == GraphType::DeltaStepping::unreachable) {
+        std::cout << " not found!\n";
+        return path;
+    }
+    for (int v = target; ; v = parent[v]) {
+        path.push_front(compact.node(v)->name());
+        if (parent[v] == v)
+            break;
+    }
+    for (auto &nodeName: path)
+        std::cout << nodeName << " ";
+    std::cout << " ------------ cost = " << distance[target];
+    return path;
+}
+
+std::vector<long long> GraphUtils::distanceTable(const Graph *graph, const std::vector<std::string> &sources,
+                                                const std::vector<std::string> &targets) {
+    CompactGraph compact(*graph);
+    auto ids = [&compact, graph](const std::vector<std::string> &names) {
+        std::vector<int> result;
+        for (const auto &name: names)
+            result.push_back(compact.id(graph->node(name)));
+        return result;
+    };
+    auto rows = ids(sources), columns = ids(targets);
+    if (std::count(rows.begin(), rows.end(), -1) > 0 || std::count(columns.begin(), columns.end(), -1) > 0)
+        return std::vector<long long>(rows.size() * columns.size(), GraphType::DistanceTable::unreachable);
+
+    GraphType::DistanceTable table(compact, GraphType::DistanceTable::Options());
+    std::vector<long long> distances;
+    std::vector<std::vector<int>> paths;
+    bool withPaths = rows.size() * columns.size() <= 100;
+    table.compute(rows, columns, distances, withPaths ? &paths : nullptr);
+    std::cout << "Таблица расстояний " << rows.size() << " x " << columns.size() << "\n";
+    if (rows.size() > 100 || columns.size() > 100)
+        return distances;
+    for (const auto &target: targets)
+        std::cout << "\t" << target;
+    std::cout << "\n";
+    for (size_t i = 0; i < rows.size(); ++i) {
+        std::cout << sources[i];
+        for (size_t j = 0; j < columns.size(); ++j) {
+            long long distance = distances[i * columns.size() + j];
+            std::cout << "\t";
+            if (distance == GraphType::DistanceTable::unreachable)
+                std::cout << "-";
+            else
+                std::cout << distance;
+        }
+        std::cout << "\n";
+    }
+    for (size_t cell = 0; withPaths && cell < paths.size(); ++cell) {
+        if (paths[cell].size() < 2)
+            continue;
+        std::cout << sources[cell / columns.size()] << " -> " << targets[cell % columns.size()] << ":";
+        for (int v: paths[cell])
+            std::cout << " " << compact.node(v)->name();
+        std::cout << "\n";
+    }
+    return distances;
+}
+
 #include <cmath>
 
-int euclideanDist(QPointF p1, QPointF p2) {
+int euclideanDist(Point p1, Point p2) {
     return (int) std::sqrt(std::pow(p1.x() - p2.x(), 2) +
                            std::pow(p1.y() - p2.y(), 2));
 }
@@ -246,6 +409,7 @@ std::list<std::string> GraphUtils::AStar(const Graph *graph, std::string start,
     dist[start] = 0;
     cost[start] = 0;
     for (int count = 0; count < graph->countNodes() - 1; count++) {
+        AlgorithmContext::step();
         auto uname = minDistance(dist, sptSet);
         sptSet[uname] = true;
         for (auto &v: nodes) {
@@ -303,6 +467,7 @@ PrimUtil(const Graph *graph, const std::string &source, bool &full, int &cost) {
     parent[source] = "";
     cost = 0;
     for (int count = 0; count < graph->countNodes(); count++) {
+        AlgorithmContext::step();
         auto u = minKey(key, mstSet);
         mstSet[u] = true;
         for (auto &node: nodes) {
@@ -346,7 +511,7 @@ printMST(const Graph &graph, const std::list<std::pair<std::string, std::string>
     std::cout << "total cost: " << cost << "\n";
 }
 
-std::list<std::pair<std::string, std::string>> GraphUtils::Prim(const Graph *graph, std::string source) {
+NodePairSequence GraphUtils::Prim(const Graph *graph, std::string source) {
     std::list<std::pair<std::string, std::string>> result;
     const auto nodes = graph->nodeList();
     bool full{};
@@ -354,7 +519,7 @@ std::list<std::pair<std::string, std::string>> GraphUtils::Prim(const Graph *gra
     if (source.empty()) {
         if (!isAllWeaklyConnected(graph)) {
             std::cout << "Minimum spanning tree: not found because the graph is not connected!";
-            return result;
+            return NodePairSequence(graph);
         }
         for (auto node: nodes) {
             int cost;
@@ -366,15 +531,16 @@ std::list<std::pair<std::string, std::string>> GraphUtils::Prim(const Graph *gra
             }
         }
         printMST(*graph, result, source, min_cost);
-        return result;
+        return nodePairs(graph, result);
     }
     result = PrimUtil(graph, source, full, min_cost);
     printMST(*graph, result, source, min_cost);
-    return result;
+    return nodePairs(graph, result);
 }
 
 void weaklyFillOrder(const Graph *graph, const std::string &vname, std::unordered_map<std::string, bool> &visited,
                      std::stack<std::string> &stack) {
+    AlgorithmContext::step();
     visited[vname] = true;
     auto nodes = graph->nodeList();
     for (auto &node: nodes)
@@ -386,6 +552,7 @@ void weaklyFillOrder(const Graph *graph, const std::string &vname, std::unordere
 
 void stronglyFillOrder(const Graph *graph, const std::string &vname, std::unordered_map<std::string, bool> &visited,
                        std::stack<std::string> &stack) {
+    AlgorithmContext::step();
     visited[vname] = true;
     auto nodes = graph->nodeList();
     for (auto &node: nodes)
@@ -441,6 +608,7 @@ void bridgeUtil(const Graph *graph, const std::string &uname,
                 std::unordered_map<std::string, std::string> &parent,
                 std::list<std::pair<std::string, std::string>> &res, int &time) {
 
+    AlgorithmContext::step();
     visited[uname] = true;
     disc[uname] = low[uname] = ++time;
     auto nodes = graph->nodeList();
@@ -482,6 +650,7 @@ void APUtil(const Graph *graph, const std::string &uname,
 
     static int time = 0;
     int children = 0;
+    AlgorithmContext::step();
     visited[uname] = true;
 
     disc[uname] = low[uname] = ++time;
@@ -567,7 +736,12 @@ bool isSafe(const Graph *graph, const std::string &vname,
     return true;
 }
 
-bool hamCycleUtil(const Graph *graph, std::vector<std::string> &path, int pos) {
+// `found` is the first branch known to close a cycle, later branches give up once it is below theirs
+bool hamCycleUtil(const Graph *graph, std::vector<std::string> &path, int pos,
+                  const std::atomic<int> &found, int branch) {
+    AlgorithmContext::step();
+    if (found.load(std::memory_order_relaxed) < branch)
+        return false;
     int n = graph->countNodes();
     if (pos == n)
         return graph->hasEdge(path[pos - 1], path[0]);
@@ -575,7 +749,7 @@ bool hamCycleUtil(const Graph *graph, std::vector<std::string> &path, int pos) {
     for (auto &v: graph->nodeList()) {
         if (v->name() != path[0] && isSafe(graph, v->name(), path, pos)) {
             path[pos] = v->name();
-            if (hamCycleUtil(graph, path, pos + 1))
+            if (hamCycleUtil(graph, path, pos + 1, found, branch))
                 return true;
             path[pos] = "";
         }
@@ -585,16 +759,38 @@ bool hamCycleUtil(const Graph *graph, std::vector<std::string> &path, int pos) {
 
 std::list<std::string> GraphUtils::getHamiltonianCircuit(const Graph *graph, std::string source) {
     auto nodes = graph->nodeList();
-    if (source.empty())
+    if (source.empty() && !nodes.empty())
         source = nodes.front()->name();
-    std::vector<std::string> path(graph->countNodes(), "");
+    int n = graph->countNodes();
     std::list<std::string> result;
-    path[0] = source;
-    if (!hamCycleUtil(graph, path, 1))
+    if (n < 2)
+        return result;
+    // The second node of the path splits the search, the lowest branch that succeeds is the sequential answer
+    std::vector<std::string> seconds;
+    for (auto &v: nodes) {
+        if (v->name() != source && graph->hasEdge(source, v->name()))
+            seconds.push_back(v->name());
+    }
+    std::vector<std::vector<std::string>> paths(seconds.size());
+    std::atomic<int> found{INT_MAX};
+    TaskScheduler::parallelFor(0, static_cast<int>(seconds.size()), [&](int from, int to) {
+        for (int i = from; i < to; ++i) {
+            paths[i].assign(n, "");
+            paths[i][0] = source;
+            paths[i][1] = seconds[i];
+            if (!hamCycleUtil(graph, paths[i], 2, found, i))
+                continue;
+            int best = found.load();
+            while (i < best && !found.compare_exchange_weak(best, i)) {
+            }
+            return;
+        }
+    });
+    if (found == INT_MAX)
         return result;
-    for (int i = 0; i < graph->countNodes(); ++i)
-        result.push_back(path[i]);
-    result.push_back(path[0]);
+    for (const auto &name: paths[found])
+        result.push_back(name);
+    result.push_back(source);
     return result;
 }
 
@@ -605,15 +801,21 @@ std::list<std::list<std::string>> GraphUtils::displayAllHamiltonianCircuits(cons
         std::cout << "|V| = " << graph->countNodes() << " < 3\n";
         return result;
     }
-    auto nodes = graph->nodeList();
-    for (auto &source: nodes) {
-        auto cycle = getHamiltonianCircuit(graph, source->name());
+    auto list = graph->nodeList();
+    std::vector<Node *> nodes(list.begin(), list.end());
+    std::vector<std::list<std::string>> cycles(nodes.size());
+    TaskScheduler::parallelFor(0, static_cast<int>(nodes.size()), [&](int from, int to) {
+        for (int i = from; i < to; ++i)
+            cycles[i] = getHamiltonianCircuit(graph, nodes[i]->name());
+    });
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const auto &cycle = cycles[i];
         if (cycle.empty())
             continue;
         else
             result.push_back(cycle);
 
-        std::cout << "Hamiltonian Circuit (source = " << source->name() << "): ";
+        std::cout << "Hamiltonian Circuit (source = " << nodes[i]->name() << "): ";
         for (auto &node: cycle)
             std::cout << node << " ";
         std::cout << "\n";
@@ -640,6 +842,7 @@ std::list<std::string> GraphUtils::Hierholzer(Graph &graph, const std::string &s
     auto curr_node = source;
     curr_path.push(source);
     while (!curr_path.empty()) {
+        AlgorithmContext::step();
         int degree = graph.isDirected() ? graph.node(curr_node)->negDegree() : graph.node(curr_node)->undirDegree();
         if (degree) {
             curr_path.push(curr_node);
@@ -666,7 +869,7 @@ std::list<std::string> GraphUtils::Hierholzer(Graph &graph, const std::string &s
 std::list<std::string> GraphUtils::getEulerianCircuit(const Graph *_graph, std::string source) {
     std::list<std::string> result;
     Graph graph(*_graph);
-    if (source.empty())
+    if (source.empty() && graph.countNodes() > 0)
         source = graph.nodeList().front()->name();
     if (!graph.hasNode(source))
         return result;
@@ -674,9 +877,8 @@ std::list<std::string> GraphUtils::getEulerianCircuit(const Graph *_graph, std::
     return result;
 }
 
-std::list<std::list<std::string>>
-GraphUtils::displayAllEulerianCircuits(const Graph *graph) {
-    std::list<std::list<std::string>> result;
+NodeGroups GraphUtils::displayAllEulerianCircuits(const Graph *graph) {
+    NodeGroups result(graph);
     if (!isAllConnected(graph)) {
         std::cout << "Цикл Эйлера не найден потому что граф не соединенён\n";
         return result;
@@ -694,10 +896,10 @@ GraphUtils::displayAllEulerianCircuits(const Graph *graph) {
         auto cycle = getEulerianCircuit(graph, node->name());
         if (!cycle.empty()) {
             std::cout << "Эйлеровый цикл(начальная вершина = " << node->name() << "): ";
-            result.emplace_back(cycle);
-            while (!cycle.empty()) {
-                std::cout << cycle.front() << " ";
-                cycle.pop_front();
+            result.startGroup();
+            for (const auto &name: cycle) {
+                result.push_back(graph->node(name));
+                std::cout << name << " ";
             }
             std::cout << "\n";
         }
@@ -707,6 +909,7 @@ GraphUtils::displayAllEulerianCircuits(const Graph *graph) {
 
 void topoSortUtil(const Graph *graph, const std::string &vname, std::unordered_map<std::string, bool> &visited,
                   std::stack<std::string> &stack) {
+    AlgorithmContext::step();
     visited[vname] = true;
     for (auto &node: graph->nodeList())
         if (graph->hasEdge(vname, node->name()) && !visited[node->name()])
@@ -727,6 +930,7 @@ bool GraphUtils::isCycle(const Graph *graph) {
     while (!q.empty()) {
         auto u = q.front();
         q.pop();
+        AlgorithmContext::step();
         top_order.push_back(u);
         for (auto v: graph->nodeList()) {
             if (--in_degree[v->name()] == 0)
@@ -778,6 +982,8 @@ std::list<std::pair<std::string, int>> GraphUtils::getColoringResult(const Graph
         return res_list;
 
     auto nodes = graph->nodeList();
+    if (nodes.empty())
+        return res_list;
     if (source.empty())
         source = nodes.front()->name();
     std::unordered_map<int, bool> available; // available colors
@@ -787,6 +993,7 @@ std::list<std::pair<std::string, int>> GraphUtils::getColoringResult(const Graph
         result[node->name()] = -1;
     result[source] = 0;
     for (auto u: nodes) {
+        AlgorithmContext::step();
         if (u->name() != source) {
             for (auto v: nodes) {
                 if (graph->hasEdge(u->name(), v->name())) {
@@ -815,17 +1022,23 @@ std::list<std::pair<std::string, int>> GraphUtils::getColoringResult(const Graph
     return res_list;
 }
 
-std::list<std::pair<std::string, std::string>> GraphUtils::displayColoring(const Graph *graph, std::string source) {
+NodeGroups GraphUtils::displayColoring(const Graph *graph, std::string source) {
+    NodeGroups classes(graph);
     if (graph->isDirected())
-        return std::list<std::pair<std::string, std::string>>();
+        return classes;
     auto result = getColoringResult(graph, std::move(source));
-    std::list<std::pair<std::string, std::string>> resultToSent;
+    std::map<int, std::vector<Node *>> colors;
     std::cout << "Coloring of the graph: " << std::endl;
     for (auto &it: result) {
         std::cout << "Node " << it.first << " ---> Color " << it.second << std::endl;
-        resultToSent.emplace_back(it.first, std::to_string(it.second));
+        colors[it.second].push_back(graph->node(it.first));
     }
-    return resultToSent;
+    for (const auto &color: colors) {
+        classes.startGroup();
+        for (auto node: color.second)
+            classes.push_back(node);
+    }
+    return classes;
 }
 
 void DFSCycle(const Graph *graph, const std::string &uname, const std::string &pname,
@@ -844,6 +1057,7 @@ void DFSCycle(const Graph *graph, const std::string &uname, const std::string &p
         }
         return;
     }
+    AlgorithmContext::step();
     parent[uname] = pname;
     color[uname] = 1;
     for (auto v: graph->nodeList()) {
@@ -860,14 +1074,13 @@ std::list<std::list<std::string>> GraphUtils::displayAllCycles(const Graph *grap
     return Gotlieb(graph);
 }
 
-std::list<std::pair<std::string, std::string>>
-GraphUtils::spanningTreeBFS(const Graph *graph, const std::string &source) {
+NodePairSequence GraphUtils::spanningTreeBFS(const Graph *graph, const std::string &source) {
     std::list<std::pair<std::string, std::string>> result;
     if (!graph->hasNode(source))
-        return result;
+        return NodePairSequence(graph);
     if (!isAllConnected(graph)) {
         std::cout << "The graph must be " << (graph->isDirected() ? "strongly " : "") << "connected";
-        return result;
+        return NodePairSequence(graph);
     }
     std::unordered_map<std::string, bool> in_unprocessed;
     std::unordered_map<std::string, bool> in_result;
@@ -879,6 +1092,7 @@ GraphUtils::spanningTreeBFS(const Graph *graph, const std::string &source) {
     std::cout << "Minimum spanning tree (source = " << source << "): " << std::endl;
     std::cout << "vertex \t parent \t cost:" << std::endl;
     while (!unprocessed_list.empty()) {
+        AlgorithmContext::step();
         auto uname = unprocessed_list.front();
         unprocessed_list.pop_front();
         in_unprocessed[uname] = false;
@@ -894,11 +1108,12 @@ GraphUtils::spanningTreeBFS(const Graph *graph, const std::string &source) {
         }
     }
     std::cout << "total cost: " << cost << std::endl;
-    return result;
+    return nodePairs(graph, result);
 }
 
 void STDFSUtil(const Graph *graph, const std::string &uname, std::unordered_map<std::string, bool> &in_tree,
                std::list<std::pair<std::string, std::string>> &result, int &cost) {
+    AlgorithmContext::step();
     for (auto v: graph->nodeList()) {
         if (graph->hasEdge(uname, v->name()) && !in_tree[v->name()]) {
             in_tree[v->name()] = true;
@@ -910,14 +1125,13 @@ void STDFSUtil(const Graph *graph, const std::string &uname, std::unordered_map<
     }
 }
 
-std::list<std::pair<std::string, std::string>>
-GraphUtils::spanningTreeDFS(const Graph *graph, const std::string &source) {
+NodePairSequence GraphUtils::spanningTreeDFS(const Graph *graph, const std::string &source) {
     std::list<std::pair<std::string, std::string>> result;
     if (!graph->hasNode(source))
-        return result;
+        return NodePairSequence(graph);
     if (!isAllConnected(graph)) {
         std::cout << "The graph must be " << (graph->isDirected() ? "strongly " : "") << "connected";
-        return result;
+        return NodePairSequence(graph);
     }
     std::unordered_map<std::string, bool> in_tree;
     in_tree[source] = true;
@@ -926,7 +1140,7 @@ GraphUtils::spanningTreeDFS(const Graph *graph, const std::string &source) {
     std::cout << "vertex \t parent \t cost:" << std::endl;
     STDFSUtil(graph, source, in_tree, result, cost);
     std::cout << "total cost: " << cost << std::endl;
-    return result;
+    return nodePairs(graph, result);
 }
 
 void
@@ -947,6 +1161,7 @@ DFSCheckCycle(std::vector<std::vector<int>> &adjMat, int u, int par, std::vector
         }
         return;
     }
+    AlgorithmContext::step();
     visited[u] = true;
     parents[u] = par;
     for (int v = 0; v < adjMat.size(); ++v) {
@@ -986,6 +1201,7 @@ std::list<std::list<std::string>> GraphUtils::Gotlieb(const Graph *graph) {
         s.push(u);
         while (!s.empty()) {
             int v = s.top();
+            AlgorithmContext::step();
             visited[v] = true;
             component[v] = 1;
             s.pop();
@@ -1039,22 +1255,23 @@ std::list<std::list<std::string>> GraphUtils::Gotlieb(const Graph *graph) {
     return result;
 }
 
-QString GraphUtils::isFull(const Graph *graph)
+std::string GraphUtils::isFull(const Graph *graph)
 {
     int n = graph->countNodes();
     int full = (n*(n-1))/2;
     return full == graph->countEdges() ? "Граф полный" : "Граф не полный";
 }
 
-QString GraphUtils::SummaryOfAllNodesDegrees(const Graph *graph)
+std::string GraphUtils::SummaryOfAllNodesDegrees(const Graph *graph)
 {
     int n = graph->countEdges() * 2;
-    return "Сумма степеней всех вершин равна " + QString::number(n);
+    return "Сумма степеней всех вершин равна " + std::to_string(n);
 }
 
 void GraphUtils::DFSRadix(const Graph *graph, const std::string &vname, std::unordered_map<std::string, bool> &visited,
                           std::list<std::string> &vertexes, int radix)
 {
+    AlgorithmContext::step();
     visited[vname] = true;
     if(radix ==0){
         vertexes.push_back(vname);
@@ -0,0 +1,502 @@
+#include "basis/headers/LayeredLayout.h"
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+using namespace GraphType;
+
+LayeredLayout::LayeredLayout(const CompactGraph &graph, const Options &options) :
+        _graph(graph),
+        _options(options) {}
+
+std::vector<std::vector<int>> LayeredLayout::acyclicArcs() const {
+    // Eades-Lin-Smyth: sinks go to the end, sources to the front, otherwise the node with most
+    // outgoing minus incoming arcs goes first; arcs pointing backwards in that order are reversed
+    int n = _graph.countNodes();
+    std::vector<int> in(n, 0), out(n, 0), inFirst(n + 1, 0), inArcs;
+    for (int u = 0; u < n; ++u) {
+        for (int arc = _graph.arcBegin(u); arc < _graph.arcEnd(u); ++arc) {
+            int v = _graph.target(arc);
+            if (v == u)
+                continue;
+            ++out[u];
+            ++in[v];
+            ++inFirst[v + 1];
+        }
+    }
+    for (int v = 0; v < n; ++v)
+        inFirst[v + 1] += inFirst[v];
+    inArcs.resize(inFirst[n]);
+    std::vector<int> fill(inFirst.begin(), inFirst.end() - 1);
+    for (int u = 0; u < n; ++u) {
+        for (int arc = _graph.arcBegin(u); arc < _graph.arcEnd(u); ++arc) {
+            if (_graph.target(arc) != u)
+                inArcs[fill[_graph.target(arc)]++] = u;
+        }
+    }
+
+    // Bins 0 and 1 hold sinks and sources, bin 2 + n + out - in the rest, as doubly linked lists
+    std::vector<int> head(2 * n + 3, -1), next(n, -1), prev(n, -1), bin(n, -1);
+    auto binOf = [&](int v) { return out[v] == 0 ? 0 : in[v] == 0 ? 1 : 2 + n + out[v] - in[v]; };
+    auto unlink = [&](int v) {
+        if (prev[v] >= 0)
+            next[prev[v]] = next[v];
+        else
+            head[bin[v]] = next[v];
+        if (next[v] >= 0)
+            prev[next[v]] = prev[v];
+    };
+    int top = 0;
+    auto link = [&](int v) {
+        bin[v] = binOf(v);
+        prev[v] = -1;
+        next[v] = head[bin[v]];
+        if (next[v] >= 0)
+            prev[next[v]] = v;
+        head[bin[v]] = v;
+        top = std::max(top, bin[v]);
+    };
+    for (int v = 0; v < n; ++v)
+        link(v);
+    std::vector<bool> removed(n, false);
+    std::vector<int> front, back;
+    front.reserve(n);
+    auto remove = [&](int v) {
+        unlink(v);
+        removed[v] = true;
+        for (int arc = _graph.arcBegin(v); arc < _graph.arcEnd(v); ++arc) {
+            int w = _graph.target(arc);
+            if (w != v && !removed[w]) {
+                unlink(w);
+                --in[w];
+                link(w);
+            }
+        }
+        for (int i = inFirst[v]; i < inFirst[v + 1]; ++i) {
+            int u = inArcs[i];
+            if (!removed[u]) {
+                unlink(u);
+                --out[u];
+                link(u);
+            }
+        }
+    };
+    for (int left = n; left > 0;) {
+        if (head[0] >= 0) {
+            back.push_back(head[0]);
+            remove(head[0]);
+        } else if (head[1] >= 0) {
+            front.push_back(head[1]);
+            remove(head[1]);
+        } else {
+            while (head[top] < 0)
+                --top;
+            front.push_back(head[top]);
+            remove(head[top]);
+        }
+        --left;
+    }
+    front.insert(front.end(), back.rbegin(), back.rend());
+    std::vector<int> rank(n);
+    for (int i = 0; i < n; ++i)
+        rank[front[i]] = i;
+
+    std::vector<std::vector<int>> arcs(n);
+    for (int u = 0; u < n; ++u) {
+        for (int arc = _graph.arcBegin(u); arc < _graph.arcEnd(u); ++arc) {
+            int v = _graph.target(arc);
+            if (v == u)
+                continue;
+            if (rank[u] < rank[v])
+                arcs[u].push_back(v);
+            else
+                arcs[v].push_back(u);
+        }
+    }
+    return arcs;
+}
+
+void LayeredLayout::assignLayers(const std::vector<std::vector<int>> &arcs) {
+    int n = _graph.countNodes();
+    std::vector<int> inDegree(n, 0);
+    for (const auto &targets: arcs) {
+        for (int v: targets)
+            ++inDegree[v];
+    }
+    std::vector<int> order;
+    order.reserve(n);
+    for (int v = 0; v < n; ++v) {
+        if (inDegree[v] == 0)
+            order.push_back(v);
+    }
+    _layer.assign(n, 0);
+    std::vector<int> remaining = inDegree;
+    for (size_t i = 0; i < order.size(); ++i) {
+        int u = order[i];
+        for (int v: arcs[u]) {
+            _layer[v] = std::max(_layer[v], _layer[u] + 1);
+            if (--remaining[v] == 0)
+                order.push_back(v);
+        }
+    }
+    // Longest paths pile every source on the top layer and stretch edges; a node with more arcs
+    // to one side than to the other shortens its arcs in total by moving to that side
+    std::vector<int> up(n, 0);
+    for (int u = 0; u < n; ++u) {
+        for (int v: arcs[u])
+            ++up[v];
+    }
+    std::vector<std::vector<int>> predecessors(n);
+    for (int u = 0; u < n; ++u) {
+        for (int v: arcs[u])
+            predecessors[v].push_back(u);
+    }
+    for (int pass = 0; pass < 8; ++pass) {
+        bool moved = false;
+        for (auto it = order.rbegin(); it != order.rend(); ++it) {
+            int v = *it;
+            auto down = static_cast<int>(arcs[v].size());
+            if (down == up[v])
+                continue;
+            int layer;
+            if (down > up[v]) {
+                layer = std::numeric_limits<int>::max();
+                for (int w: arcs[v])
+                    layer = std::min(layer, _layer[w] - 1);
+            } else {
+                layer = 0;
+                for (int w: predecessors[v])
+                    layer = std::max(layer, _layer[w] + 1);
+            }
+            if (layer != _layer[v]) {
+                _layer[v] = layer;
+                moved = true;
+            }
+        }
+        if (!moved)
+            break;
+    }
+    int lowest = std::numeric_limits<int>::max();
+    for (int layer: _layer)
+        lowest = std::min(lowest, layer);
+    for (int &layer: _layer)
+        layer -= lowest;
+}
+
+void LayeredLayout::insertDummies(const std::vector<std::vector<int>> &arcs) {
+    int n = _graph.countNodes();
+    _up.assign(n, std::vector<int>());
+    _down.assign(n, std::vector<int>());
+    for (int u = 0; u < n; ++u) {
+        for (int v: arcs[u]) {
+            int last = u;
+            for (int layer = _layer[u] + 1; layer < _layer[v]; ++layer) {
+                auto dummy = static_cast<int>(_layer.size());
+                _layer.push_back(layer);
+                _up.emplace_back(1, last);
+                _down.emplace_back();
+                _down[last].push_back(dummy);
+                last = dummy;
+            }
+            _down[last].push_back(v);
+            _up[v].push_back(last);
+        }
+    }
+    int height = 0;
+    for (int layer: _layer)
+        height = std::max(height, layer + 1);
+    _layers.assign(height, std::vector<int>());
+}
+
+void LayeredLayout::initialOrder() {
+    // Depth-first order puts the nodes of a chain below each other from the start
+    auto count = static_cast<int>(_layer.size());
+    std::vector<bool> visited(count, false);
+    std::vector<int> stack;
+    for (int start = 0; start < _graph.countNodes(); ++start) {
+        if (visited[start] || !_up[start].empty())
+            continue;
+        visited[start] = true;
+        stack.push_back(start);
+        while (!stack.empty()) {
+            int u = stack.back();
+            stack.pop_back();
+            _layers[_layer[u]].push_back(u);
+            for (auto it = _down[u].rbegin(); it != _down[u].rend(); ++it) {
+                if (!visited[*it]) {
+                    visited[*it] = true;
+                    stack.push_back(*it);
+                }
+            }
+        }
+    }
+    _pos.assign(count, 0);
+    for (const auto &layer: _layers) {
+        for (size_t i = 0; i < layer.size(); ++i)
+            _pos[layer[i]] = static_cast<int>(i);
+    }
+}
+
+void LayeredLayout::sweep(bool downwards) {
+    auto height = static_cast<int>(_layers.size());
+    std::vector<std::pair<double, int>> keys;
+    for (int step = 1; step < height; ++step) {
+        auto &layer = _layers[downwards ? step : height - 1 - step];
+        const auto &neighbours = downwards ? _up : _down;
+        keys.clear();
+        for (int v: layer) {
+            const auto &fixed = neighbours[v];
+            // A node without neighbours on the fixed layer stays where it is
+            double barycenter = _pos[v];
+            if (!fixed.empty()) {
+                barycenter = 0;
+                for (int u: fixed)
+                    barycenter += _pos[u];
+                barycenter /= fixed.size();
+            }
+            keys.emplace_back(barycenter, v);
+        }
+        std::stable_sort(keys.begin(), keys.end(), [](const std::pair<double, int> &a,
+                                                      const std::pair<double, int> &b) {
+            return a.first < b.first;
+        });
+        for (size_t i = 0; i < keys.size(); ++i) {
+            layer[i] = keys[i].second;
+            _pos[layer[i]] = static_cast<int>(i);
+        }
+    }
+}
+
+long long LayeredLayout::countCrossings() const {
+    long long crossings = 0;
+    std::vector<int> south, targets;
+    std::vector<long long> tree;
+    for (size_t i = 0; i + 1 < _layers.size(); ++i) {
+        // Lower ends in the order of the upper ends, every inversion is a crossing
+        south.clear();
+        for (int u: _layers[i]) {
+            targets.clear();
+            for (int v: _down[u])
+                targets.push_back(_pos[v]);
+            std::sort(targets.begin(), targets.end());
+            south.insert(south.end(), targets.begin(), targets.end());
+        }
+        size_t first = 1;
+        while (first < _layers[i + 1].size())
+            first *= 2;
+        tree.assign(2 * first - 1, 0);
+        for (int p: south) {
+            size_t index = p + first - 1;
+            ++tree[index];
+            while (index > 0) {
+                if (index % 2 == 1)
+                    crossings += tree[index + 1];
+                index = (index - 1) / 2;
+                ++tree[index];
+            }
+        }
+    }
+    return crossings;
+}
+
+std::unordered_set<long long> LayeredLayout::markConflicts() const {
+    std::unordered_set<long long> conflicts;
+    auto count = static_cast<long long>(_layer.size());
+    for (size_t i = 0; i + 1 < _layers.size(); ++i) {
+        const auto &upper = _layers[i], &lower = _layers[i + 1];
+        int k0 = 0;
+        size_t l = 0;
+        for (size_t l1 = 0; l1 < lower.size(); ++l1) {
+            int v = lower[l1];
+            int inner = isDummy(v) && isDummy(_up[v][0]) ? _up[v][0] : -1;
+            if (l1 + 1 != lower.size() && inner < 0)
+                continue;
+            int k1 = inner >= 0 ? _pos[inner] : static_cast<int>(upper.size()) - 1;
+            for (; l <= l1; ++l) {
+                int w = lower[l];
+                for (int u: _up[w]) {
+                    if ((_pos[u] < k0 || _pos[u] > k1) && !(isDummy(u) && isDummy(w)))
+                        conflicts.insert(u * count + w);
+                }
+            }
+            k0 = k1;
+        }
+    }
+    return conflicts;
+}
+
+double LayeredLayout::separation(int u, int v) const {
+    double a = isDummy(u) ? _options.dummySpacing : _options.nodeSpacing;
+    double b = isDummy(v) ? _options.dummySpacing : _options.nodeSpacing;
+    return (a + b) / 2;
+}
+
+std::vector<double> LayeredLayout::place(bool upwards, bool rightwards,
+                                         const std::unordered_set<long long> &conflicts) const {
+    auto count = static_cast<int>(_layer.size());
+    auto height = static_cast<int>(_layers.size());
+    // Mirror the layering so that alignment always runs top down and compaction left to right
+    std::vector<std::vector<int>> layers(height);
+    std::vector<int> pos(count);
+    for (int i = 0; i < height; ++i) {
+        layers[i] = _layers[upwards ? height - 1 - i : i];
+        if (rightwards)
+            std::reverse(layers[i].begin(), layers[i].end());
+        for (size_t j = 0; j < layers[i].size(); ++j)
+            pos[layers[i][j]] = static_cast<int>(j);
+    }
+    const auto &above = upwards ? _down : _up;
+
+    // Vertical alignment of every node with a median neighbour above, without crossing earlier alignments
+    std::vector<int> root(count), align(count);
+    for (int v = 0; v < count; ++v)
+        root[v] = align[v] = v;
+    std::vector<int> medians;
+    for (int i = 1; i < height; ++i) {
+        int r = -1;
+        for (int v: layers[i]) {
+            medians = above[v];
+            if (medians.empty())
+                continue;
+            std::sort(medians.begin(), medians.end(), [&pos](int a, int b) { return pos[a] < pos[b]; });
+            auto d = static_cast<int>(medians.size());
+            for (int m = (d - 1) / 2; m <= d / 2; ++m) {
+                if (align[v] != v)
+                    break;
+                int u = medians[m];
+                long long key = upwards ? static_cast<long long>(v) * count + u : static_cast<long long>(u) * count + v;
+                if (conflicts.count(key) == 0 && r < pos[u]) {
+                    align[u] = v;
+                    root[v] = root[u];
+                    align[v] = root[v];
+                    r = pos[u];
+                }
+            }
+        }
+    }
+
+    // Horizontal compaction of whole blocks: leftmost positions first, then pulled right towards free space
+    std::vector<std::vector<std::pair<int, double>>> right(count), left(count);
+    std::vector<int> inDegree(count, 0);
+    for (const auto &layer: layers) {
+        for (size_t j = 1; j < layer.size(); ++j) {
+            int a = root[layer[j - 1]], b = root[layer[j]];
+            double gap = separation(layer[j - 1], layer[j]);
+            right[a].emplace_back(b, gap);
+            left[b].emplace_back(a, gap);
+            ++inDegree[b];
+        }
+    }
+    std::vector<int> order;
+    for (int v = 0; v < count; ++v) {
+        if (root[v] == v && inDegree[v] == 0)
+            order.push_back(v);
+    }
+    for (size_t i = 0; i < order.size(); ++i) {
+        for (const auto &edge: right[order[i]]) {
+            if (--inDegree[edge.first] == 0)
+                order.push_back(edge.first);
+        }
+    }
+    std::vector<double> xs(count, 0);
+    for (int b: order) {
+        for (const auto &edge: left[b])
+            xs[b] = std::max(xs[b], xs[edge.first] + edge.second);
+    }
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        if (right[*it].empty())
+            continue;
+        double limit = std::numeric_limits<double>::max();
+        for (const auto &edge: right[*it])
+            limit = std::min(limit, xs[edge.first] - edge.second);
+        xs[*it] = std::max(xs[*it], limit);
+    }
+    std::vector<double> x(count);
+    for (int v = 0; v < count; ++v)
+        x[v] = rightwards ? -xs[root[v]] : xs[root[v]];
+    return x;
+}
+
+bool LayeredLayout::run(std::vector<double> &x, std::vector<double> &y, LayoutMonitor &monitor) {
+    int n = _graph.countNodes();
+    if (n == 0)
+        return true;
+    {
+        auto arcs = acyclicArcs();
+        assignLayers(arcs);
+        insertDummies(arcs);
+    }
+    initialOrder();
+    monitor.progress(10);
+
+    this->_crossings = countCrossings();
+    auto best = _layers;
+    int stale = 0;
+    for (int s = 0; s < _options.sweeps && _crossings > 0 && stale < 4; ++s) {
+        if (monitor.cancelled())
+            return false;
+        sweep(s % 2 == 0);
+        long long crossings = countCrossings();
+        if (crossings < _crossings) {
+            this->_crossings = crossings;
+            best = _layers;
+            stale = 0;
+        } else {
+            ++stale;
+        }
+        monitor.progress(10 + 70 * (s + 1) / _options.sweeps);
+    }
+    this->_layers = std::move(best);
+    for (const auto &layer: _layers) {
+        for (size_t i = 0; i < layer.size(); ++i)
+            _pos[layer[i]] = static_cast<int>(i);
+    }
+    if (monitor.cancelled())
+        return false;
+
+    // Four extreme placements, shifted onto the narrowest one and balanced by their median
+    auto conflicts = markConflicts();
+    std::vector<std::vector<double>> candidates;
+    for (int direction = 0; direction < 4; ++direction) {
+        candidates.push_back(place(direction / 2 == 1, direction % 2 == 1, conflicts));
+        monitor.progress(80 + 5 * (direction + 1));
+    }
+    std::vector<double> minimum(4), maximum(4);
+    int narrowest = 0;
+    for (int c = 0; c < 4; ++c) {
+        auto range = std::minmax_element(candidates[c].begin(), candidates[c].end());
+        minimum[c] = *range.first;
+        maximum[c] = *range.second;
+        if (maximum[c] - minimum[c] < maximum[narrowest] - minimum[narrowest])
+            narrowest = c;
+    }
+    for (int c = 0; c < 4; ++c) {
+        double shift = c % 2 == 0 ? minimum[narrowest] - minimum[c] : maximum[narrowest] - maximum[c];
+        for (double &value: candidates[c])
+            value += shift;
+    }
+
+    double cx = 0, cy = 0;
+    for (int v = 0; v < n; ++v) {
+        cx += x[v] / n;
+        cy += y[v] / n;
+    }
+    double values[4];
+    double mx = 0, my = 0;
+    std::vector<double> lx(n), ly(n);
+    for (int v = 0; v < n; ++v) {
+        for (int c = 0; c < 4; ++c)
+            values[c] = candidates[c][v];
+        std::sort(values, values + 4);
+        lx[v] = (values[1] + values[2]) / 2;
+        ly[v] = _layer[v] * _options.layerSpacing;
+        mx += lx[v] / n;
+        my += ly[v] / n;
+    }
+    // The drawing stays where the graph was
+    for (int v = 0; v < n; ++v) {
+        x[v] = lx[v] - mx + cx;
+        y[v] = ly[v] - my + cy;
+    }
+    return true;
+}
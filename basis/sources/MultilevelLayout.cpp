@@ -0,0 +1,199 @@
+#include "basis/headers/MultilevelLayout.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace GraphType;
+
+MultilevelLayout::MultilevelLayout(const CompactGraph &graph, const Options &options) :
+        _graph(graph),
+        _options(options) {
+    while (countLevels() < _options.maxLevels) {
+        const CompactGraph &coarsest = level(countLevels() - 1);
+        if (coarsest.countNodes() <= _options.coarsestSize || !coarsen(coarsest))
+            break;
+    }
+}
+
+bool MultilevelLayout::coarsen(const CompactGraph &graph) {
+    int n = graph.countNodes();
+    // On the graph itself every edge counts once, coarse arcs carry the number of edges they stand for
+    bool original = &graph == &_graph;
+    std::vector<int> order(n);
+    for (int i = 0; i < n; ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&graph](int a, int b) {
+        return graph.degree(a) < graph.degree(b);
+    });
+    std::vector<int> parent(n, -1);
+    int count = 0;
+    for (int u: order) {
+        if (parent[u] >= 0)
+            continue;
+        int best = -1, bestWeight = 0;
+        for (int arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) {
+            int v = graph.target(arc);
+            if (v == u || parent[v] >= 0)
+                continue;
+            int weight = original ? 1 : graph.weight(arc);
+            if (best < 0 || weight > bestWeight || (weight == bestWeight && graph.degree(v) < graph.degree(best))) {
+                best = v;
+                bestWeight = weight;
+            }
+        }
+        parent[u] = count;
+        if (best >= 0)
+            parent[best] = count;
+        ++count;
+    }
+    // Matching barely shrinks stars, so leaves left alone join their neighbour
+    std::vector<int> size(count, 0);
+    for (int u = 0; u < n; ++u)
+        ++size[parent[u]];
+    for (int u = 0; u < n; ++u) {
+        if (size[parent[u]] != 1 || graph.degree(u) != 1)
+            continue;
+        int v = graph.target(graph.arcBegin(u));
+        if (v == u || size[parent[v]] == 1)
+            continue;
+        --size[parent[u]];
+        parent[u] = parent[v];
+        ++size[parent[v]];
+    }
+    std::vector<int> renumber(count, -1);
+    int coarse = 0;
+    for (int c = 0; c < count; ++c) {
+        if (size[c] > 0)
+            renumber[c] = coarse++;
+    }
+    if (coarse > n * 0.95)
+        return false;
+    for (int u = 0; u < n; ++u)
+        parent[u] = renumber[parent[u]];
+
+    // Arcs of all members of a coarse node, parallel arcs merged by summing their weights
+    std::vector<int> members(n), first(coarse + 1, 0);
+    for (int u = 0; u < n; ++u)
+        ++first[parent[u] + 1];
+    for (int c = 0; c < coarse; ++c)
+        first[c + 1] += first[c];
+    std::vector<int> fill(first.begin(), first.end() - 1);
+    for (int u = 0; u < n; ++u)
+        members[fill[parent[u]]++] = u;
+    std::vector<int> offsets(coarse + 1, 0), targets, weights, slot(coarse, -1);
+    for (int c = 0; c < coarse; ++c) {
+        for (int m = first[c]; m < first[c + 1]; ++m) {
+            int u = members[m];
+            for (int arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) {
+                int t = parent[graph.target(arc)];
+                if (t == c)
+                    continue;
+                int weight = original ? 1 : graph.weight(arc);
+                if (slot[t] < offsets[c]) {
+                    slot[t] = static_cast<int>(targets.size());
+                    targets.push_back(t);
+                    weights.push_back(weight);
+                } else {
+                    weights[slot[t]] += weight;
+                }
+            }
+        }
+        offsets[c + 1] = static_cast<int>(targets.size());
+    }
+    _levels.emplace_back(std::move(offsets), std::move(targets), std::move(weights));
+    _parents.push_back(std::move(parent));
+    return true;
+}
+
+std::vector<int> MultilevelLayout::ancestors(int l) const {
+    std::vector<int> result(_graph.countNodes());
+    for (int v = 0; v < _graph.countNodes(); ++v) {
+        int a = v;
+        for (int i = 0; i < l; ++i)
+            a = _parents[i][a];
+        result[v] = a;
+    }
+    return result;
+}
+
+bool MultilevelLayout::run(std::vector<double> &x, std::vector<double> &y, LayoutMonitor &monitor) {
+    int n = _graph.countNodes();
+    if (n == 0)
+        return true;
+    int top = countLevels() - 1;
+    double k = _options.force.idealLength;
+
+    // Work of a level is its size times its iterations
+    std::vector<double> work(top + 1);
+    double total = 0, done = 0;
+    for (int l = 0; l <= top; ++l) {
+        int iterations = l == top ? _options.force.iterations : _options.refineIterations;
+        work[l] = static_cast<double>(level(l).countNodes()) * iterations;
+        total += work[l];
+    }
+
+    // The coarsest level starts from the centers of what its nodes were merged from
+    std::vector<int> anc = ancestors(top);
+    int m = level(top).countNodes();
+    std::vector<double> lx(m, 0), ly(m, 0), weight(m, 0);
+    for (int v = 0; v < n; ++v) {
+        lx[anc[v]] += x[v];
+        ly[anc[v]] += y[v];
+        weight[anc[v]] += 1;
+    }
+    for (int c = 0; c < m; ++c) {
+        lx[c] /= weight[c];
+        ly[c] /= weight[c];
+    }
+
+    for (int l = top; l >= 0; --l) {
+        const CompactGraph &graph = level(l);
+        // A coarse node stands for n / size nodes, so keep the area of the drawing the same on every level
+        double length = k * std::sqrt(static_cast<double>(n) / graph.countNodes());
+        ForceLayout::Options options = _options.force;
+        options.idealLength = length;
+        if (l == top) {
+            ForceLayout::fit(lx, ly, length);
+        } else {
+            options.iterations = _options.refineIterations;
+            options.temperature = length;
+        }
+        ForceLayout layout(graph, std::move(lx), std::move(ly), options);
+        bool cancelled = false;
+        while (layout.step()) {
+            if (monitor.cancelled()) {
+                cancelled = true;
+                break;
+            }
+            monitor.progress(static_cast<int>(100 * (done + work[l] * layout.iteration() / options.iterations) / total));
+            if (monitor.wantsFrame()) {
+                std::vector<double> fx(n), fy(n);
+                for (int v = 0; v < n; ++v) {
+                    fx[v] = layout.x()[anc[v]];
+                    fy[v] = layout.y()[anc[v]];
+                }
+                monitor.frame(fx, fy);
+            }
+        }
+        done += work[l];
+        if (cancelled || l == 0) {
+            for (int v = 0; v < n; ++v) {
+                x[v] = layout.x()[anc[v]];
+                y[v] = layout.y()[anc[v]];
+            }
+            return !cancelled;
+        }
+
+        // Members start around their coarse node, spread a little so they do not coincide
+        const std::vector<int> &parent = _parents[l - 1];
+        int finer = level(l - 1).countNodes();
+        lx.assign(finer, 0);
+        ly.assign(finer, 0);
+        double spread = length * 0.1;
+        for (int v = 0; v < finer; ++v) {
+            lx[v] = layout.x()[parent[v]] + spread * std::cos(v * 2.39996);
+            ly[v] = layout.y()[parent[v]] + spread * std::sin(v * 2.39996);
+        }
+        anc = ancestors(l - 1);
+    }
+    return true;
+}
@@ -6,10 +6,9 @@ GraphType::Node::Node(std::string name) {
     this->_degNeg = 0;
     this->_degPos = 0;
     this->_deg = 0;
-    this->_euclidePos = QPointF(0, 0);
 }
 
-GraphType::Node::Node(std::string name, QPointF pos) {
+GraphType::Node::Node(std::string name, Point pos) {
     this->_name = std::move(name);
     this->_degNeg = 0;
     this->_degPos = 0;
@@ -0,0 +1,50 @@
+#include "basis/headers/NodeSequence.h"
+
+using namespace GraphType;
+
+const std::string &NodeNames::name(NodeId id) const {
+    static const std::string none;
+    return _graph.hasNode(id) ? _graph.node(id).name : none;
+}
+
+NodeId NodeNames::find(const std::string &name) const {
+    for (NodeId id = 0; id < _graph.nodeCapacity(); ++id)
+        if (_graph.hasNode(id) && _graph.node(id).name == name)
+            return id;
+    return -1;
+}
+
+std::list<std::string> NodeSequence::names() const {
+    std::list<std::string> result;
+    for (NodeId id: _ids)
+        result.push_back(name(id));
+    return result;
+}
+
+std::ostream &GraphType::operator<<(std::ostream &os, const NodeSequence &sequence) {
+    for (NodeId id: sequence._ids)
+        os << sequence.name(id) << " ";
+    return os;
+}
+
+std::list<std::pair<std::string, std::string>> NodePairSequence::names() const {
+    std::list<std::pair<std::string, std::string>> result;
+    for (const auto &pair: _pairs)
+        result.emplace_back(name(pair.first), name(pair.second));
+    return result;
+}
+
+size_t NodeGroups::groupSize(size_t group) const {
+    size_t end = group + 1 < _offsets.size() ? _offsets[group + 1] : _ids.size();
+    return end - _offsets[group];
+}
+
+std::list<std::list<std::string>> NodeGroups::names() const {
+    std::list<std::list<std::string>> result;
+    for (size_t group = 0; group < size(); ++group) {
+        result.emplace_back();
+        for (size_t i = 0; i < groupSize(group); ++i)
+            result.back().push_back(name(at(group, i)));
+    }
+    return result;
+}
@@ -0,0 +1,172 @@
+#include "basis/headers/ParallelBFS.h"
+#include "basis/headers/AlgorithmContext.h"
+#include "basis/headers/TaskScheduler.h"
+#include <algorithm>
+
+using namespace GraphType;
+
+namespace {
+    inline int lowestBit(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(word);
+#else
+        int bit = 0;
+        while (!(word & 1)) {
+            word >>= 1;
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    // Whole words per slice, a slice of bitset words covers 64 nodes each
+    const int wordGrain = 16;
+}
+
+ParallelBFS::ParallelBFS(const CompactGraph &graph, const Options &options) :
+        _graph(graph),
+        _options(options),
+        _reverse(graph.isSymmetric() ? CompactGraph({0}, {}, {}) : graph.reversed()) {
+}
+
+void ParallelBFS::run(int source, std::vector<int> &depth, std::vector<int> &parent) {
+    int n = _graph.countNodes();
+    depth.assign(n, -1);
+    parent.assign(n, -1);
+    this->_topDownSteps = this->_bottomUpSteps = 0;
+    if (source < 0 || source >= n)
+        return;
+    int words = (n + 63) / 64;
+    if (static_cast<int>(_visited.size()) != words) {
+        this->_visited = std::vector<std::atomic<Word>>(words);
+        this->_frontier = std::vector<std::atomic<Word>>(words);
+        this->_next = std::vector<std::atomic<Word>>(words);
+    }
+    TaskScheduler::parallelFor(0, words, [this](int from, int to) {
+        for (int w = from; w < to; ++w) {
+            _visited[w].store(0, std::memory_order_relaxed);
+            _frontier[w].store(0, std::memory_order_relaxed);
+        }
+    }, 1024);
+    Word bit = Word(1) << (source & 63);
+    _visited[source >> 6].store(bit, std::memory_order_relaxed);
+    _frontier[source >> 6].store(bit, std::memory_order_relaxed);
+    depth[source] = 0;
+    parent[source] = source;
+
+    long long frontierNodes = 1;
+    long long frontierArcs = _graph.degree(source);
+    long long unexploredArcs = _graph.countArcs() - frontierArcs;
+    bool bottomUp = false;
+    for (int level = 1; frontierNodes > 0; ++level) {
+        AlgorithmContext::step(frontierNodes);
+        if (!bottomUp && frontierArcs > unexploredArcs / _options.alpha)
+            bottomUp = true;
+        else if (bottomUp && frontierNodes < n / _options.beta)
+            bottomUp = false;
+        long long count = 0;
+        if (bottomUp) {
+            frontierArcs = this->bottomUp(level, depth, parent, count);
+            ++_bottomUpSteps;
+        } else {
+            frontierArcs = topDown(level, depth, parent, count);
+            ++_topDownSteps;
+        }
+        unexploredArcs -= frontierArcs;
+        frontierNodes = count;
+        std::swap(_frontier, _next);
+    }
+    settleParents(depth, parent);
+}
+
+long long ParallelBFS::topDown(int level, std::vector<int> &depth, std::vector<int> &parent, long long &count) {
+    int words = static_cast<int>(_frontier.size());
+    TaskScheduler::parallelFor(0, words, [this](int from, int to) {
+        for (int w = from; w < to; ++w)
+            _next[w].store(0, std::memory_order_relaxed);
+    }, 1024);
+    std::atomic<long long> arcs{0}, found{0};
+    TaskScheduler::parallelFor(0, words, [&](int from, int to) {
+        long long sliceArcs = 0, sliceFound = 0;
+        for (int w = from; w < to; ++w) {
+            Word bits = _frontier[w].load(std::memory_order_relaxed);
+            while (bits) {
+                int u = w * 64 + lowestBit(bits);
+                bits &= bits - 1;
+                for (int arc = _graph.arcBegin(u); arc < _graph.arcEnd(u); ++arc) {
+                    int v = _graph.target(arc);
+                    Word mask = Word(1) << (v & 63);
+                    auto &visited = _visited[v >> 6];
+                    // The plain load skips the locked or for nodes seen before, the or decides who claims the rest
+                    if ((visited.load(std::memory_order_relaxed) & mask)
+                        || (visited.fetch_or(mask, std::memory_order_relaxed) & mask))
+                        continue;
+                    parent[v] = u;
+                    depth[v] = level;
+                    _next[v >> 6].fetch_or(mask, std::memory_order_relaxed);
+                    ++sliceFound;
+                    sliceArcs += _graph.degree(v);
+                }
+            }
+        }
+        arcs += sliceArcs;
+        found += sliceFound;
+    }, wordGrain);
+    count = found;
+    return arcs;
+}
+
+long long ParallelBFS::bottomUp(int level, std::vector<int> &depth, std::vector<int> &parent, long long &count) {
+    int n = _graph.countNodes();
+    int words = static_cast<int>(_frontier.size());
+    std::atomic<long long> arcs{0}, found{0};
+    const auto &in = incoming();
+    // Every slice owns its words of the visited and next sets, no claims are needed
+    TaskScheduler::parallelFor(0, words, [&](int from, int to) {
+        long long sliceArcs = 0, sliceFound = 0;
+        for (int w = from; w < to; ++w) {
+            Word unvisited = ~_visited[w].load(std::memory_order_relaxed);
+            if (w == words - 1 && n % 64 != 0)
+                unvisited &= (Word(1) << (n % 64)) - 1;
+            Word added = 0;
+            while (unvisited) {
+                int b = lowestBit(unvisited);
+                unvisited &= unvisited - 1;
+                int v = w * 64 + b;
+                for (int arc = in.arcBegin(v); arc < in.arcEnd(v); ++arc) {
+                    int u = in.target(arc);
+                    if (!((_frontier[u >> 6].load(std::memory_order_relaxed) >> (u & 63)) & 1))
+                        continue;
+                    parent[v] = u;
+                    depth[v] = level;
+                    added |= Word(1) << b;
+                    ++sliceFound;
+                    sliceArcs += _graph.degree(v);
+                    break;
+                }
+            }
+            if (added)
+                _visited[w].fetch_or(added, std::memory_order_relaxed);
+            _next[w].store(added, std::memory_order_relaxed);
+        }
+        arcs += sliceArcs;
+        found += sliceFound;
+    }, wordGrain);
+    count = found;
+    return arcs;
+}
+
+void ParallelBFS::settleParents(const std::vector<int> &depth, std::vector<int> &parent) {
+    const auto &in = incoming();
+    TaskScheduler::parallelFor(0, _graph.countNodes(), [&](int from, int to) {
+        for (int v = from; v < to; ++v) {
+            if (depth[v] <= 0)
+                continue;
+            for (int arc = in.arcBegin(v); arc < in.arcEnd(v); ++arc) {
+                int u = in.target(arc);
+                if (depth[u] == depth[v] - 1 && u < parent[v])
+                    parent[v] = u;
+            }
+        }
+    }, 1024);
+}
@@ -0,0 +1,51 @@
+#include "basis/headers/PlaybackTimeline.h"
+
+using namespace GraphType;
+
+PlaybackTimeline::PlaybackTimeline(const NodeNames &names) :
+        _names(names),
+        _directed(names.graph().isDirected()),
+        _nodeStates(names.graph().nodeCapacity(), -1) {}
+
+void PlaybackTimeline::startStep() {
+    _steps.push_back(_changes.size());
+}
+
+void PlaybackTimeline::setNode(NodeId id, int state) {
+    if (id < 0 || id >= static_cast<NodeId>(_nodeStates.size()))
+        return;
+    record(id, -1, _nodeStates[id], state);
+}
+
+void PlaybackTimeline::setEdge(NodeId u, NodeId v, int state) {
+    auto capacity = static_cast<long long>(_nodeStates.size());
+    if (u < 0 || v < 0 || u >= capacity || v >= capacity)
+        return;
+    // Either end names an undirected edge
+    if (!_directed && v < u)
+        std::swap(u, v);
+    auto it = _edgeStates.emplace(u * capacity + v, -1).first;
+    record(u, v, it->second, state);
+}
+
+void PlaybackTimeline::clear() {
+    for (const auto &element: _selected) {
+        if (element.second < 0)
+            setNode(element.first, -1);
+        else
+            setEdge(element.first, element.second, -1);
+    }
+    _selected.clear();
+}
+
+void PlaybackTimeline::record(NodeId u, NodeId v, int &current, int state) {
+    if (current == state)
+        return;
+    if (_steps.empty())
+        startStep();
+    if (current < 0)
+        _selected.emplace_back(u, v);
+    _changes.push_back({u, v, current, state});
+    current = state;
+    this->_colors = std::max(_colors, state);
+}
@@ -0,0 +1,196 @@
+#include "basis/headers/TaskScheduler.h"
+#include "basis/headers/AlgorithmContext.h"
+#include <algorithm>
+
+using namespace GraphType;
+
+const int TaskScheduler::_maxThreads;
+
+thread_local int TaskScheduler::_workerIndex = 0;
+
+TaskScheduler::TaskScheduler() {
+    for (int i = 0; i < _maxThreads; ++i)
+        _queues.emplace_back(new Queue());
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        this->_stopping = true;
+    }
+    _wake.notify_all();
+    _parked.notify_all();
+    for (auto &worker: _workers)
+        worker.join();
+}
+
+TaskScheduler &TaskScheduler::instance() {
+    static TaskScheduler scheduler;
+    static std::once_flag started;
+    std::call_once(started, []() { scheduler.resize(0); });
+    return scheduler;
+}
+
+void TaskScheduler::setThreadCount(int count) {
+    instance().resize(count);
+}
+
+int TaskScheduler::threadCount() {
+    return instance()._active.load();
+}
+
+void TaskScheduler::resize(int threads) {
+    if (threads <= 0)
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    threads = std::min(threads, _maxThreads);
+    std::lock_guard<std::mutex> lock(_workersMutex);
+    // Workers beyond the count are parked rather than stopped, their queues are still stolen from
+    while (static_cast<int>(_workers.size()) < threads - 1) {
+        int index = static_cast<int>(_workers.size()) + 1;
+        _workers.emplace_back(&TaskScheduler::work, this, index);
+        this->_queueCount = index + 1;
+    }
+    {
+        std::lock_guard<std::mutex> sleepLock(_sleepMutex);
+        this->_active = threads;
+    }
+    _wake.notify_all();
+    _parked.notify_all();
+}
+
+void TaskScheduler::push(Task task) {
+    auto &queue = *_queues[_workerIndex];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        ++_queued;
+    }
+    _wake.notify_one();
+}
+
+bool TaskScheduler::take(Task &task) {
+    if (_queued.load() == 0)
+        return false;
+    int count = _queueCount.load();
+    for (int i = 0; i < count; ++i) {
+        int index = (_workerIndex + i) % count;
+        auto &queue = *_queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+            continue;
+        // The owner takes its newest task, thieves the oldest, which tends to be the largest
+        if (i == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        --_queued;
+        return true;
+    }
+    return false;
+}
+
+void TaskScheduler::work(int index) {
+    _workerIndex = index;
+    Task task;
+    while (true) {
+        if (index < _active.load() && take(task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        if (index >= _active.load())
+            _parked.wait(lock, [this, index]() { return _stopping || index < _active.load(); });
+        else
+            _wake.wait(lock, [this, index]() { return _stopping || index >= _active.load() || _queued.load() > 0; });
+        if (_stopping)
+            return;
+    }
+}
+
+void TaskScheduler::parallelFor(int begin, int end, const std::function<void(int, int)> &body, int minGrain) {
+    int count = end - begin;
+    if (count <= 0)
+        return;
+    int threads = threadCount();
+    // Eight slices a thread leave stealing enough room to even out uneven slices
+    int grain = std::max(std::max(1, minGrain), count / (threads * 8));
+    if (threads == 1 || count <= grain) {
+        body(begin, end);
+        return;
+    }
+    // Declared before the group, whose destructor waits for the tasks that use it
+    std::function<void(int, int)> split;
+    TaskGroup group;
+    split = [&](int from, int to) {
+        while (to - from > grain) {
+            int middle = from + (to - from) / 2;
+            group.run([&split, middle, to]() { split(middle, to); });
+            to = middle;
+        }
+        body(from, to);
+    };
+    split(begin, end);
+    group.wait();
+}
+
+TaskScheduler::TaskGroup::~TaskGroup() {
+    try {
+        wait();
+    } catch (...) {
+    }
+}
+
+void TaskScheduler::TaskGroup::run(Task task) {
+    ++_pending;
+    auto context = AlgorithmContext::current();
+    instance().push([this, task, context]() {
+        AlgorithmContext::Scope scope(context);
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_error)
+                this->_error = std::current_exception();
+        }
+        finish();
+    });
+}
+
+void TaskScheduler::TaskGroup::finish() {
+    // The group may be gone once the count is zero, only the scheduler is touched after that
+    if (_pending.fetch_sub(1) > 1)
+        return;
+    auto &scheduler = instance();
+    std::lock_guard<std::mutex> lock(scheduler._sleepMutex);
+    scheduler._wake.notify_all();
+}
+
+void TaskScheduler::TaskGroup::wait() {
+    auto &scheduler = instance();
+    Task task;
+    while (_pending.load() > 0) {
+        if (scheduler.take(task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+        // The rest of the group runs elsewhere, sleep until it is done or more work is queued
+        std::unique_lock<std::mutex> lock(scheduler._sleepMutex);
+        scheduler._wake.wait(lock, [this, &scheduler]() {
+            return _pending.load() == 0 || scheduler._queued.load() > 0;
+        });
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_error) {
+        auto error = _error;
+        this->_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
@@ -0,0 +1,209 @@
+#include "basis/headers/TreeLayout.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace GraphType;
+
+TreeLayout::TreeLayout(const NodePairSequence &edges, const Options &options) :
+        _options(options) {
+    std::vector<int> index(edges.graph().nodeCapacity(), -1);
+    auto id = [&](NodeId node) {
+        if (index[node] < 0) {
+            index[node] = static_cast<int>(_ids.size());
+            _ids.push_back(node);
+        }
+        return index[node];
+    };
+    std::vector<int> parent;
+    for (size_t i = 0; i < edges.size(); ++i) {
+        if (!edges.graph().hasNode(edges.to(i)))
+            continue;
+        int child = id(edges.to(i));
+        int p = !edges.graph().hasNode(edges.from(i)) || edges.from(i) == edges.to(i) ? -1 : id(edges.from(i));
+        parent.resize(_ids.size(), -1);
+        if (p >= 0 || parent[child] < 0)
+            parent[child] = p;
+    }
+    parent.resize(_ids.size(), -1);
+
+    auto n = static_cast<int>(_ids.size());
+    int root = n;
+    _children.assign(n + 1, std::vector<int>());
+    for (int v = 0; v < n; ++v) {
+        if (parent[v] >= 0)
+            _children[parent[v]].push_back(v);
+    }
+    _parent.assign(n + 1, -1);
+    std::vector<bool> reached(n + 1, false);
+    reached[root] = true;
+    // Roots go first, whatever a parent cycle keeps out of their reach is cut loose as another root
+    std::vector<int> starts, stack;
+    for (int v = 0; v < n; ++v) {
+        if (parent[v] < 0)
+            starts.push_back(v);
+    }
+    for (int v = 0; v < n; ++v)
+        starts.push_back(v);
+    for (int start: starts) {
+        if (reached[start])
+            continue;
+        reached[start] = true;
+        _parent[start] = root;
+        stack.push_back(start);
+        while (!stack.empty()) {
+            int u = stack.back();
+            stack.pop_back();
+            for (int w: _children[u]) {
+                if (!reached[w]) {
+                    reached[w] = true;
+                    _parent[w] = u;
+                    stack.push_back(w);
+                }
+            }
+        }
+    }
+    for (auto &children: _children)
+        children.clear();
+    for (int v = 0; v < n; ++v)
+        _children[_parent[v]].push_back(v);
+    _number.assign(n + 1, 0);
+    for (const auto &children: _children) {
+        for (size_t i = 0; i < children.size(); ++i)
+            _number[children[i]] = static_cast<int>(i);
+    }
+}
+
+void TreeLayout::place(int v) {
+    int left = leftSibling(v);
+    double x = left >= 0 ? _prelim[left] + _options.siblingSpacing : 0;
+    if (_children[v].empty()) {
+        _prelim[v] = x;
+    } else if (left >= 0) {
+        _prelim[v] = x;
+        _mod[v] = x - _midpoint[v];
+    } else {
+        _prelim[v] = _midpoint[v];
+    }
+}
+
+int TreeLayout::apportion(int v, int defaultAncestor) {
+    int w = leftSibling(v);
+    if (w < 0)
+        return defaultAncestor;
+    // Inner and outer contours of the subtrees to the left (l) and of v's subtree (r)
+    int vir = v, vor = v, vil = w, vol = _children[_parent[v]].front();
+    double sir = _mod[vir], sor = _mod[vor], sil = _mod[vil], sol = _mod[vol];
+    while (nextRight(vil) >= 0 && nextLeft(vir) >= 0) {
+        vil = nextRight(vil);
+        vir = nextLeft(vir);
+        vol = nextLeft(vol);
+        vor = nextRight(vor);
+        _ancestor[vor] = v;
+        double shift = (_prelim[vil] + sil) - (_prelim[vir] + sir) + _options.siblingSpacing;
+        if (shift > 0) {
+            int a = _parent[_ancestor[vil]] == _parent[v] ? _ancestor[vil] : defaultAncestor;
+            moveSubtree(a, v, shift);
+            sir += shift;
+            sor += shift;
+        }
+        sil += _mod[vil];
+        sir += _mod[vir];
+        sol += _mod[vol];
+        sor += _mod[vor];
+    }
+    if (nextRight(vil) >= 0 && nextRight(vor) < 0) {
+        _thread[vor] = nextRight(vil);
+        _mod[vor] += sil - sor;
+    }
+    if (nextLeft(vir) >= 0 && nextLeft(vol) < 0) {
+        _thread[vol] = nextLeft(vir);
+        _mod[vol] += sir - sol;
+        defaultAncestor = v;
+    }
+    return defaultAncestor;
+}
+
+void TreeLayout::moveSubtree(int left, int right, double shift) {
+    double subtrees = _number[right] - _number[left];
+    _change[right] -= shift / subtrees;
+    _shift[right] += shift;
+    _change[left] += shift / subtrees;
+    _prelim[right] += shift;
+    _mod[right] += shift;
+}
+
+void TreeLayout::executeShifts(int v) {
+    double shift = 0, change = 0;
+    for (auto it = _children[v].rbegin(); it != _children[v].rend(); ++it) {
+        _prelim[*it] += shift;
+        _mod[*it] += shift;
+        change += _change[*it];
+        shift += _shift[*it] + change;
+    }
+}
+
+void TreeLayout::run(std::vector<double> &x, std::vector<double> &y) {
+    auto n = static_cast<int>(_ids.size());
+    x.assign(n, 0);
+    y.assign(n, 0);
+    if (n == 0)
+        return;
+    int root = n;
+    _prelim.assign(n + 1, 0);
+    _mod.assign(n + 1, 0);
+    _shift.assign(n + 1, 0);
+    _change.assign(n + 1, 0);
+    _midpoint.assign(n + 1, 0);
+    _thread.assign(n + 1, -1);
+    _ancestor.resize(n + 1);
+    for (int v = 0; v <= n; ++v)
+        _ancestor[v] = v;
+
+    std::vector<int> order;
+    order.reserve(n + 1);
+    order.push_back(root);
+    for (size_t i = 0; i < order.size(); ++i) {
+        for (int w: _children[order[i]])
+            order.push_back(w);
+    }
+    // Breadth-first order reversed has every subtree finished before its root
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        int v = *it;
+        if (_children[v].empty())
+            continue;
+        int defaultAncestor = _children[v].front();
+        for (int w: _children[v]) {
+            place(w);
+            defaultAncestor = apportion(w, defaultAncestor);
+        }
+        executeShifts(v);
+        _midpoint[v] = (_prelim[_children[v].front()] + _prelim[_children[v].back()]) / 2;
+    }
+
+    std::vector<double> sum(n + 1, 0);
+    std::vector<int> depth(n + 1, 0);
+    for (int v: order) {
+        if (v == root)
+            continue;
+        sum[v] = sum[_parent[v]] + _mod[_parent[v]];
+        depth[v] = _parent[v] == root ? 0 : depth[_parent[v]] + 1;
+        x[v] = _prelim[v] + sum[v];
+        y[v] = depth[v] * _options.levelSpacing;
+    }
+    double origin = x[_children[root].front()];
+    for (double &value: x)
+        value -= origin;
+    if (!_options.radial)
+        return;
+
+    // Rows become rings, the width of the tidy drawing is spread over the full circle
+    auto range = std::minmax_element(x.begin(), x.end());
+    double low = *range.first, span = *range.second - low + _options.siblingSpacing;
+    double offset = _children[root].size() > 1 ? 1 : 0;
+    for (int v = 0; v < n; ++v) {
+        double angle = 2 * M_PI * (x[v] - low) / span;
+        double radius = (depth[v] + offset) * _options.levelSpacing;
+        x[v] = radius * std::cos(angle);
+        y[v] = radius * std::sin(angle);
+    }
+}
@@ -0,0 +1,27 @@
+# Every algorithm graph_cli lists must answer an empty and a comment-only file with a JSON line;
+# batch jobs rely on a bad file costing one line of output rather than the whole run
+file(WRITE ${WORK_DIR}/empty_graph.txt "")
+file(WRITE ${WORK_DIR}/comment_graph.txt "# nodes and edges follow\n% none here\n")
+
+execute_process(COMMAND ${GRAPH_CLI} --list OUTPUT_VARIABLE algorithms RESULT_VARIABLE status)
+if (NOT status EQUAL 0)
+    message(FATAL_ERROR "graph_cli --list failed: ${status}")
+endif ()
+string(REPLACE "\n" ";" algorithms "${algorithms}")
+
+foreach (algorithm ${algorithms})
+    foreach (directed "" "--directed")
+        execute_process(COMMAND ${GRAPH_CLI} ${directed} ${algorithm}
+                ${WORK_DIR}/empty_graph.txt ${WORK_DIR}/comment_graph.txt
+                OUTPUT_VARIABLE output RESULT_VARIABLE status)
+        # 0 for results, 1 when a file reports an error; anything else is a crash
+        if (NOT (status EQUAL 0 OR status EQUAL 1))
+            message(FATAL_ERROR "graph_cli ${directed} ${algorithm} on empty graphs: ${status}")
+        endif ()
+        string(REGEX MATCHALL "\"algorithm\":\"${algorithm}\"" lines "${output}")
+        list(LENGTH lines count)
+        if (NOT count EQUAL 2)
+            message(FATAL_ERROR "graph_cli ${directed} ${algorithm} on empty graphs printed ${count} lines:\n${output}")
+        endif ()
+    endforeach ()
+endforeach ()
@@ -0,0 +1,343 @@
+#include "basis/headers/Graph.h"
+#include "basis/headers/GraphUtils.h"
+#include "basis/headers/DistanceTable.h"
+#include "basis/headers/TaskScheduler.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ * Runs GraphUtils algorithms on graph files without the GUI, for batch jobs:
+ *
+ *     graph_cli [options] ALGORITHM FILE...
+ *
+ * Every file gives one line of JSON on stdout with the graph size, load and run times in
+ * milliseconds and the result, or the error. What the algorithms print goes to stderr
+ * with --verbose and nowhere otherwise. Files ending in .gph are read as saved by the
+ * GUI, anything else as an edge list.
+ */
+
+namespace {
+
+    struct Options {
+        std::string source;
+        std::string target;
+        bool directed = false;
+        bool verbose = false;
+    };
+
+    // Collects what a result is made of as JSON members
+    class Json {
+
+    public:
+        void field(const std::string &key, const std::string &value) {
+            member(key);
+            string(value);
+        }
+
+        void field(const std::string &key, long long value) {
+            member(key);
+            _out << value;
+        }
+
+        void field(const std::string &key, double value) {
+            member(key);
+            _out << value;
+        }
+
+        void field(const std::string &key, bool value) {
+            member(key);
+            _out << (value ? "true" : "false");
+        }
+
+        void field(const std::string &key, const std::list<std::string> &names) {
+            member(key);
+            array(names);
+        }
+
+        void field(const std::string &key, const std::list<std::list<std::string>> &groups) {
+            member(key);
+            _out << "[";
+            for (auto it = groups.begin(); it != groups.end(); ++it) {
+                if (it != groups.begin())
+                    _out << ",";
+                array(*it);
+            }
+            _out << "]";
+        }
+
+        void field(const std::string &key, const std::list<std::pair<std::string, std::string>> &pairs) {
+            member(key);
+            _out << "[";
+            for (auto it = pairs.begin(); it != pairs.end(); ++it) {
+                if (it != pairs.begin())
+                    _out << ",";
+                _out << "[";
+                string(it->first);
+                _out << ",";
+                string(it->second);
+                _out << "]";
+            }
+            _out << "]";
+        }
+
+        // Rows of `columns` distances, null where there is no path
+        void field(const std::string &key, const std::vector<long long> &distances, size_t columns) {
+            member(key);
+            _out << "[";
+            for (size_t i = 0; i < distances.size(); ++i) {
+                _out << (i == 0 ? "[" : i % columns == 0 ? "],[" : ",");
+                if (distances[i] == GraphType::DistanceTable::unreachable)
+                    _out << "null";
+                else
+                    _out << distances[i];
+            }
+            _out << (distances.empty() ? "]" : "]]");
+        }
+
+        std::string str() const { return "{" + _out.str() + "}"; }
+
+    private:
+        std::ostringstream _out;
+        bool _first = true;
+
+        void member(const std::string &key) {
+            if (!_first)
+                _out << ",";
+            this->_first = false;
+            string(key);
+            _out << ":";
+        }
+
+        void array(const std::list<std::string> &names) {
+            _out << "[";
+            for (auto it = names.begin(); it != names.end(); ++it) {
+                if (it != names.begin())
+                    _out << ",";
+                string(*it);
+            }
+            _out << "]";
+        }
+
+        void string(const std::string &value) {
+            _out << '"';
+            for (char c: value) {
+                if (c == '"' || c == '\\')
+                    _out << '\\' << c;
+                else if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    _out << escaped;
+                } else
+                    _out << c;
+            }
+            _out << '"';
+        }
+    };
+
+    typedef std::function<void(const Graph &, const Options &, Json &)> Algorithm;
+
+    std::vector<std::string> split(const std::string &list) {
+        std::vector<std::string> names;
+        std::istringstream in(list);
+        std::string name;
+        while (std::getline(in, name, ','))
+            names.push_back(name);
+        return names;
+    }
+
+    std::vector<std::string> allNames(const Graph &graph) {
+        std::vector<std::string> names;
+        for (auto node: graph.nodeList())
+            names.push_back(node->name());
+        return names;
+    }
+
+    const std::map<std::string, Algorithm> &algorithms() {
+        static const std::map<std::string, Algorithm> table{
+                {"bfs", [](const Graph &graph, const Options &options, Json &json) {
+                    json.field("order", GraphUtils::BFS(&graph, options.source).names());
+                }},
+                {"dfs", [](const Graph &graph, const Options &options, Json &json) {
+                    json.field("order", GraphUtils::DFS(&graph, options.source).names());
+                }},
+                {"bfs-tree", [](const Graph &graph, const Options &options, Json &json) {
+                    json.field("tree", GraphUtils::BFSTree(&graph, options.source).names());
+                }},
+                {"spanning-tree-bfs", [](const Graph &graph, const Options &options, Json &json) {
+                    json.field("tree", GraphUtils::spanningTreeBFS(&graph, options.source).names());
+                }},
+                {"spanning-tree-dfs", [](const Graph &graph, const Options &options, Json &json) {
+                    json.field("tree", GraphUtils::spanningTreeDFS(&graph, options.source).names());
+                }},
+                {"prim", [](const Graph &graph, const Options &options, Json &json) {
+                    json.field("tree", GraphUtils::Prim(&graph, options.source).names());
+                }},
+                {"dijkstra", [](const Graph &graph, const Options &options, Json &json) {
+                    json.field("path", GraphUtils::Dijkstra(&graph, options.source, options.target));
+                }},
+                {"delta-stepping", [](const Graph &graph, const Options &options, Json &json) {
+                    json.field("path", GraphUtils::DeltaSteppingPath(&graph, options.source, options.target));
+                }},
+                {"astar", [](const Graph &graph, const Options &options, Json &json) {
+                    json.field("path", GraphUtils::AStar(&graph, options.source, options.target));
+                }},
+                {"distance-table", [](const Graph &graph, const Options &options, Json &json) {
+                    auto sources = options.source.empty() ? allNames(graph) : split(options.source);
+                    auto targets = options.target.empty() ? allNames(graph) : split(options.target);
+                    json.field("sources", std::list<std::string>(sources.begin(), sources.end()));
+                    json.field("targets", std::list<std::string>(targets.begin(), targets.end()));
+                    json.field("distances", GraphUtils::distanceTable(&graph, sources, targets), targets.size());
+                }},
+                {"components", [](const Graph &graph, const Options &, Json &json) {
+                    json.field("components", GraphUtils::connectedComponents(&graph));
+                }},
+                {"weak-components", [](const Graph &graph, const Options &, Json &json) {
+                    json.field("components", GraphUtils::weaklyConnectedComponents(&graph));
+                }},
+                {"connected", [](const Graph &graph, const Options &, Json &json) {
+                    json.field("connected", GraphUtils::isAllConnected(&graph));
+                }},
+                {"weakly-connected", [](const Graph &graph, const Options &, Json &json) {
+                    json.field("connected", GraphUtils::isAllWeaklyConnected(&graph));
+                }},
+                {"bridges", [](const Graph &graph, const Options &, Json &json) {
+                    json.field("bridges", GraphUtils::getBridges(&graph));
+                }},
+                {"articulation-nodes", [](const Graph &graph, const Options &, Json &json) {
+                    json.field("nodes", GraphUtils::getArticulationNodes(&graph));
+                }},
+                {"eulerian-circuit", [](const Graph &graph, const Options &options, Json &json) {
+                    json.field("circuit", GraphUtils::getEulerianCircuit(&graph, options.source));
+                }},
+                {"hamiltonian-circuit", [](const Graph &graph, const Options &options, Json &json) {
+                    json.field("circuit", GraphUtils::getHamiltonianCircuit(&graph, options.source));
+                }},
+                {"topological-sort", [](const Graph &graph, const Options &, Json &json) {
+                    json.field("order", GraphUtils::getTopoSortResult(&graph));
+                }},
+                {"coloring", [](const Graph &graph, const Options &options, Json &json) {
+                    json.field("classes", GraphUtils::displayColoring(&graph, options.source).names());
+                }},
+                {"cyclic", [](const Graph &graph, const Options &, Json &json) {
+                    json.field("cyclic", GraphUtils::isCycle(&graph));
+                }},
+                {"cycles", [](const Graph &graph, const Options &, Json &json) {
+                    json.field("cycles", GraphUtils::displayAllCycles(&graph));
+                }},
+        };
+        return table;
+    }
+
+    double millisecondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    bool endsWith(const std::string &text, const std::string &suffix) {
+        return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    // Discards what algorithms print unless asked for
+    class NullBuffer : public std::streambuf {
+    protected:
+        int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+    };
+
+    // False if the file could not be read or the algorithm failed
+    bool run(const std::string &file, const std::string &name, const Algorithm &algorithm,
+             const Options &options, std::string &line) {
+        bool ok = true;
+        Json json;
+        json.field("file", file);
+        json.field("algorithm", name);
+        try {
+            auto start = std::chrono::steady_clock::now();
+            auto graph = endsWith(file, ".gph") ? Graph::readFromFile(file)
+                                                : Graph::readEdgeList(file, options.directed);
+            json.field("load_ms", millisecondsSince(start));
+            json.field("nodes", static_cast<long long>(graph.countNodes()));
+            json.field("edges", static_cast<long long>(graph.countEdges()));
+            start = std::chrono::steady_clock::now();
+            algorithm(graph, options, json);
+            json.field("run_ms", millisecondsSince(start));
+        } catch (const char *error) {
+            json.field("error", std::string(error));
+            ok = false;
+        } catch (const std::exception &error) {
+            json.field("error", std::string(error.what()));
+            ok = false;
+        }
+        line = json.str();
+        return ok;
+    }
+
+    void usage(std::ostream &out) {
+        out << "Usage: graph_cli [options] ALGORITHM FILE...\n"
+               "  --source NAME    source node, a comma-separated list for distance-table\n"
+               "  --target NAME    target node, a comma-separated list for distance-table\n"
+               "  --directed       read edge lists as directed graphs\n"
+               "  --threads N      threads for parallel algorithms, 0 for all cores\n"
+               "  --verbose        send what the algorithms print to stderr\n"
+               "  --list           list the algorithms\n";
+    }
+}
+
+int main(int argc, char *argv[]) {
+    Options options;
+    std::vector<std::string> arguments;
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        bool has_value = i + 1 < argc;
+        if (argument == "--source" && has_value)
+            options.source = argv[++i];
+        else if (argument == "--target" && has_value)
+            options.target = argv[++i];
+        else if (argument == "--threads" && has_value)
+            GraphType::TaskScheduler::setThreadCount(std::atoi(argv[++i]));
+        else if (argument == "--directed")
+            options.directed = true;
+        else if (argument == "--verbose")
+            options.verbose = true;
+        else if (argument == "--list") {
+            for (const auto &it: algorithms())
+                std::cout << it.first << "\n";
+            return 0;
+        } else if (argument == "--help" || argument == "-h") {
+            usage(std::cout);
+            return 0;
+        } else if (argument.compare(0, 2, "--") == 0) {
+            usage(std::cerr);
+            return 2;
+        } else
+            arguments.push_back(argument);
+    }
+    if (arguments.size() < 2) {
+        usage(std::cerr);
+        return 2;
+    }
+    auto it = algorithms().find(arguments[0]);
+    if (it == algorithms().end()) {
+        std::cerr << "Unknown algorithm " << arguments[0] << ", see --list\n";
+        return 2;
+    }
+
+    // Results go to stdout itself, std::cout is left to the algorithms
+    std::ostream results(std::cout.rdbuf());
+    NullBuffer discard;
+    std::cout.rdbuf(options.verbose ? std::cerr.rdbuf() : &discard);
+    int failed = 0;
+    for (size_t i = 1; i < arguments.size(); ++i) {
+        std::string line;
+        if (!run(arguments[i], it->first, it->second, options, line))
+            ++failed;
+        results << line << std::endl;
+    }
+    std::cout.rdbuf(results.rdbuf());
+    return failed > 0 ? 1 : 0;
+}
@@ -3,6 +3,7 @@
 
 #include <basis/headers/Edge.h>
 #include "NodeGraphicsItem.h"
+#include <QStaticText>
 
 class QGraphicsLineItem;
 
@@ -39,6 +40,8 @@ public:
 
     QPainterPath shape() const override;
 
+    bool contains(const QPointF &point) const override;
+
     GraphType::Edge edge() const;
 
     bool inversionAvailable() const;
@@ -56,15 +59,33 @@ public slots:
 protected:
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
 
-    void hoverEnterEvent(QGraphicsSceneHoverEvent *event) override;
-
 private:
+    void updateGeometry();
+
+    bool geometryChanged() const;
+
     GraphGraphicsScene *_gscene;
     NodeGraphicsItem *_startItem;
     NodeGraphicsItem *_endItem;
     QColor _color;
     QColor _onSelectedColor;
+    QPointF _startPos;
+    QPointF _endPos;
+    int _weight = 0;
+    bool _inverted = false;
     QPainterPath _path;
+    QPainterPath _shape;
+    QStaticText _weightLabel;
+    QPointF _weightPos;
+    QPointF _bend;
+    QRectF _weightRect;
+
+    // Below these view scales the weight is skipped and the edge is drawn as a hairline
+    static constexpr qreal _weightDetail = 0.5;
+    static constexpr qreal _lineDetail = 0.25;
+    static constexpr qreal _hitTolerance = 6;
+
+    static const QFont &weightFont();
 };
 
 #endif // EDGEGRAPHICSITEM_H
@@ -0,0 +1,89 @@
+#ifndef EDGELAYERITEM_H
+#define EDGELAYERITEM_H
+
+#include "basis/headers/Edge.h"
+#include "QuadTree.h"
+#include <QGraphicsItem>
+#include <QLineF>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class GraphGraphicsScene;
+
+/*
+ * Draws every edge of a large graph from flat arrays instead of one
+ * EdgeGraphicsItem per edge. Visible edges are looked up in a quadtree and
+ * drawn with a few batched drawLines calls; an edge that needs its own item
+ * (selected, highlighted by a demo) is hidden here while that item exists.
+ */
+class EdgeLayerItem : public QGraphicsItem {
+public:
+    enum {
+        Type = UserType + 6
+    };
+
+    typedef std::pair<std::string, std::string> Key;
+
+    explicit EdgeLayerItem(GraphGraphicsScene *scene);
+
+    int type() const override { return Type; }
+
+    QRectF boundingRect() const override;
+
+    QPainterPath shape() const override;
+
+    bool contains(const QPointF &point) const override;
+
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
+    void setEdge(const Key &key, const QPointF &p1, const QPointF &p2, int weight);
+
+    bool removeEdge(const Key &key);
+
+    bool hasEdge(const Key &key) const { return _ids.find(key) != _ids.end(); }
+
+    void setHidden(const Key &key, bool hidden);
+
+    void moveNode(const std::string &name, const QPointF &pos);
+
+    void removeNode(const std::string &name);
+
+    void clear();
+
+    int count() const { return static_cast<int>(_ids.size()); }
+
+    // Returns false when no visible edge passes within `tolerance` of the point
+    bool edgeAt(const QPointF &point, Key &key, qreal tolerance = 6) const;
+
+    // Adds the two strokes of an arrow head pointing at the rim of a default-sized end node
+    static void appendArrowHead(const QLineF &line, std::vector<QLineF> &heads);
+
+private:
+    enum Flag : unsigned char {
+        Alive = 1, Hidden = 2
+    };
+
+    GraphGraphicsScene *_gscene;
+    std::vector<QLineF> _lines;
+    std::vector<int> _weights;
+    std::vector<unsigned char> _flags;
+    std::vector<Key> _keys;
+    std::vector<int> _free;
+    std::unordered_map<Key, int> _ids;
+    std::unordered_map<std::string, std::vector<int>> _incident;
+    QuadTree _index;
+    QRectF _bounds;
+
+    static constexpr qreal _margin = 20;
+    static constexpr qreal _arrowDetail = 0.35;
+    static constexpr qreal _weightDetail = 0.5;
+    static constexpr int _weightLimit = 2000;
+
+    void place(int id, const QLineF &line);
+
+    static QRectF lineRect(const QLineF &line);
+};
+
+#endif // EDGELAYERITEM_H
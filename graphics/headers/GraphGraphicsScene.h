@@ -2,8 +2,15 @@
 #define GRAPHGRAPHICSSCENE_H
 
 #include "basis/headers/Graph.h"
+#include "basis/headers/NodeSequence.h"
+#include "basis/headers/PlaybackTimeline.h"
+#include "basis/headers/AlgorithmStepper.h"
 #include "NodeGraphicsItem.h"
 #include "EdgeGraphicsItem.h"
+#include "EdgeLayerItem.h"
+#include "QuadTree.h"
+#include "TileCache.h"
+#include "HitIndex.h"
 #include <QGraphicsScene>
 #include <QtWidgets>
 
@@ -24,6 +31,52 @@ public:
 
     void clearAll();
 
+    // Draws all edges through one EdgeLayerItem instead of one item per edge
+    void setBatchedEdges(bool enabled);
+
+    bool batchedEdges() const { return this->_batchedEdges; }
+
+    EdgeGraphicsItem *edgeItemAt(const QPointF &scenePos);
+
+    // Hit tests against node circles and edge segments, creating the item if it does not exist yet
+    QGraphicsItem *hitItem(const QPointF &scenePos);
+
+    QList<QGraphicsItem *> hitItems(const QRectF &sceneRect);
+
+    bool isHit(const QPointF &scenePos) const;
+
+    // Keeps node positions in flat arrays and creates node items only around the visible rect
+    void setVirtualized(bool enabled);
+
+    bool virtualized() const { return this->_virtualized; }
+
+    // Paints the graph from pre-rendered background tiles, items only draw what differs from them
+    void setTiledRendering(bool enabled);
+
+    bool tiledRendering() const { return this->_tiledRendering; }
+
+    bool tilesActive() const { return _tiledRendering && _tiles->ready(); }
+
+    // Places many nodes at once, e.g. from a running layout; positions are written to the nodes too
+    void moveNodes(const std::vector<GraphType::Node *> &nodes, const std::vector<QPointF> &positions);
+
+    // Glides nodes from where they are to new positions, e.g. into an alternative arrangement
+    void animateNodes(const std::vector<GraphType::Node *> &nodes, const std::vector<QPointF> &positions,
+                      int duration = 500);
+
+    // Coalesces redraw requests into at most one needRedraw per frame
+    void requestRedraw();
+
+    // Shows a run while it goes, pulling as many steps a frame as the speed and the frame budget allow;
+    // only pausing and stepping forward work on it
+    void demoStepwise(std::unique_ptr<GraphType::AlgorithmStepper> stepper, GraphDemoFlag flag);
+
+    bool demoPlaying() const { return _demoTimer.isActive(); }
+
+    double demoSpeed() const { return this->_demoSpeed; }
+
+    bool demoReversed() const { return this->_demoReversed; }
+
     friend class GraphGraphicsView;
 
     ~GraphGraphicsScene() override;
@@ -32,25 +85,62 @@ public slots:
 
     void reload();
 
+    void nodeAdded(const std::string &name);
+
+    void nodeRemoved(const std::string &name);
+
+    void nodeIsolated(const std::string &name);
+
+    void nodeRenamed(const std::string &old_name, const std::string &new_name);
+
+    void edgeAdded(const std::string &uname, const std::string &vname);
+
+    void edgeRemoved(const std::string &uname, const std::string &vname);
+
+    void weightChanged(const std::string &uname, const std::string &vname);
+
+    void edgeChanged(const std::string &uname, const std::string &vname);
+
+    void applyEvents(const std::vector<GraphType::GraphEvent> &events);
+
+    void setVisibleRect(const QRectF &rect);
+
+    // Milliseconds per step of a demo played at normal speed
     void setInterval(int interval) {
-        interval = 300;
-        this->_interval = 300;
-        if (_uniqueTimer)
-            this->_uniqueTimer->setInterval(interval);
+        this->_interval = std::max(interval, 1);
     }
 
-    void demoAlgorithm(const std::list<std::pair<std::string, std::string>> &listOfPairToDemo, GraphDemoFlag flag);
+    void demoAlgorithm(const GraphType::NodePairSequence &pairs, GraphDemoFlag flag);
 
-    void demoAlgorithm(const std::list<std::string> &listOfNodeToDemo, GraphDemoFlag flag);
+    void demoAlgorithm(const GraphType::NodeSequence &nodes, GraphDemoFlag flag);
 
-    void demoAlgorithm(const std::list<std::list<std::string>> &listOfListToDemo, GraphDemoFlag flag);
+    void demoAlgorithm(const GraphType::NodeGroups &groups, GraphDemoFlag flag);
 
-signals:
+    void playDemo();
 
-    void graphChanged();
+    void pauseDemo();
+
+    // Pauses and moves by `steps`, backwards if negative
+    void stepDemo(int steps);
+
+    void seekDemo(int step);
+
+    // Multiplies the normal speed
+    void setDemoSpeed(double speed);
+
+    void setDemoReversed(bool reversed);
+
+signals:
 
     void needRedraw();
 
+    void demoPositionChanged(int position, int count);
+
+protected:
+    void drawBackground(QPainter *painter, const QRectF &rect) override;
+
+    void drawForeground(QPainter *painter, const QRectF &rect) override;
+
 private:
 
     using QGraphicsScene::clear;
@@ -58,16 +148,101 @@ private:
     GraphType::Graph *_graph{};
     std::unordered_map<std::string, NodeGraphicsItem *> _nodeItems;
     std::unordered_map<std::pair<std::string, std::string>, EdgeGraphicsItem *> _edgeItems;
+    EdgeLayerItem *_edgeLayer{};
+    bool _batchedEdges = false;
+    bool _autoBatchedEdges = true;
+    static constexpr int _batchedEdgesThreshold = 5000;
+
+    bool _virtualized = false;
+    bool _autoVirtualized = true;
+    bool _nodesCollapsed = false;
+    std::vector<GraphType::Node *> _virtualNodes;
+    std::vector<QPointF> _positions;
+    std::unordered_map<std::string, int> _virtualIds;
+    QuadTree _nodeIndex;
+    QRectF _nodeBounds;
+    QRectF _visibleRect;
+    std::vector<NodeGraphicsItem *> _nodePool;
+    static constexpr int _virtualizedThreshold = 20000;
+    static constexpr int _materializeLimit = 4000;
+    static constexpr qreal _virtualMargin = 200;
+
+    HitIndex _hits;
+
+    bool _bulkMove = false;
+
+    QVariantAnimation _animation;
+    std::vector<GraphType::Node *> _animatedNodes;
+    std::vector<QPointF> _animationFrom, _animationTo;
+    unsigned long _animationVersion = 0;
+
+    TileCache *_tiles;
+    bool _tiledRendering = false;
+    bool _autoTiledRendering = true;
 
     EdgeGraphicsItem *edgeItem(const std::string &uname, const std::string &vname);
 
     NodeGraphicsItem *nodeItem(const std::string &name);
 
-    std::unique_ptr<QTimer> _uniqueTimer;
-    std::list<std::string> _listOfNode;
-    std::list<std::list<std::string>> _listOfList;
-    std::list<std::pair<std::string, std::string>> _listOfPair;
-    int _interval;
+    NodeGraphicsItem *addNodeItem(GraphType::Node *node);
+
+    void releaseNodeItem(const std::string &name);
+
+    void indexNode(GraphType::Node *node);
+
+    void unindexNode(const std::string &name);
+
+    void moveIndexedNode(const std::string &name, const QPointF &pos);
+
+    void materialize();
+
+    EdgeGraphicsItem *createEdgeItem(const GraphType::NodePair &pair);
+
+    EdgeGraphicsItem *promoteEdge(const std::string &uname, const std::string &vname);
+
+    void demoteEdges();
+
+    void removeEdgeItem(const std::pair<std::string, std::string> &key);
+
+    void removeIncidentEdgeItems(const std::string &name);
+
+    void updateReverseEdgeItem(const std::string &uname, const std::string &vname);
+
+    void syncEdgeItem(GraphType::Node *u, GraphType::Node *v);
+
+    QTimer _redrawTimer;
+    // The result being played, every frame shows as many steps as the speed asks for
+    GraphType::PlaybackTimeline _demo;
+    std::vector<QColor> _demoColors;
+    // What the demo shows by name, so items made or recycled while it runs show it too
+    std::unordered_map<std::string, int> _demoNodeStates;
+    std::unordered_map<std::pair<std::string, std::string>, int> _demoEdgeStates;
+    QTimer _demoTimer;
+    QElapsedTimer _demoClock;
+    double _demoSpeed = 1;
+    double _demoCarry = 0;
+    bool _demoReversed = false;
+    int _interval = 300;
+    // Large results speed up to be played within this many seconds
+    static constexpr double _demoLongest = 30;
+    // A run shown while it goes, instead of _demo
+    std::unique_ptr<GraphType::AlgorithmStepper> _stepper;
+    GraphDemoFlag _stepperFlag = GraphDemoFlag::EdgeAndNode;
+    static constexpr qint64 _frameBudget = 8;
+
+    void startDemo(GraphType::PlaybackTimeline timeline);
+
+    void advanceDemo();
+
+    void advanceStepper(long long steps);
+
+    void showDemoState(const GraphType::NodeNames &names, GraphType::NodeId u, GraphType::NodeId v, int state);
+
+    void applyDemoState(NodeGraphicsItem *item, int state);
+
+    void applyDemoState(EdgeGraphicsItem *item, int state);
+
+    void restoreDemoEdges();
 
     void resetAfterDemoAlgo();
 };
@@ -5,6 +5,7 @@
 #include <QGraphicsView>
 #include <QContextMenuEvent>
 #include <QMenu>
+#include <QRubberBand>
 
 enum StartAlgoFlag {
     DFS, BFS, Dijkstra, AStar, Prim, ST_DFS, ST_BFS
@@ -21,6 +22,10 @@ private:
     NodeGraphicsItem *_startItem{};
     qreal _currentScale;
     const qreal _scaleMax = 1.5;
+    QRubberBand *_rubberBand{};
+    QPoint _rubberOrigin;
+
+    void updateVisibleRect();
 
 public:
     GraphGraphicsView();
@@ -38,8 +43,14 @@ protected:
 
     void mousePressEvent(QMouseEvent *event) override;
 
+    void mouseMoveEvent(QMouseEvent *event) override;
+
     void mouseReleaseEvent(QMouseEvent *event) override;
 
+    void scrollContentsBy(int dx, int dy) override;
+
+    void resizeEvent(QResizeEvent *event) override;
+
 signals:
 
     void unSelected();
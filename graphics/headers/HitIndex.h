@@ -0,0 +1,75 @@
+#ifndef HITINDEX_H
+#define HITINDEX_H
+
+#include "basis/headers/Edge.h"
+#include "QuadTree.h"
+#include <QLineF>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+ * Geometry of every node circle and edge segment in the scene, kept in two
+ * quadtrees so that clicks, hovering and rubber bands are answered without
+ * asking the graphics items for their painter paths. It covers the whole
+ * graph, including nodes and edges that currently have no item.
+ */
+class HitIndex {
+public:
+    typedef std::pair<std::string, std::string> Key;
+
+    void setNode(const std::string &name, const QPointF &center, qreal radius);
+
+    void moveNode(const std::string &name, const QPointF &center);
+
+    void removeNode(const std::string &name);
+
+    void setEdge(const Key &key, const QPointF &p1, const QPointF &p2);
+
+    void removeEdge(const Key &key);
+
+    void removeIncidentEdges(const std::string &name);
+
+    void clear();
+
+    // The node whose center is closest to the point among those covering it
+    bool nodeAt(const QPointF &point, std::string &name) const;
+
+    bool edgeAt(const QPointF &point, Key &key, qreal tolerance = 6) const;
+
+    void nodesIn(const QRectF &rect, std::vector<std::string> &names) const;
+
+    void edgesIn(const QRectF &rect, std::vector<Key> &keys) const;
+
+    static qreal distance(const QPointF &point, const QLineF &line);
+
+    static bool crosses(const QLineF &line, const QRectF &rect);
+
+private:
+    struct NodeEntry {
+        QPointF center;
+        qreal radius;
+        std::string name;
+    };
+
+    struct EdgeEntry {
+        QLineF line;
+        Key key;
+    };
+
+    std::vector<NodeEntry> _nodes;
+    std::vector<int> _freeNodes;
+    std::unordered_map<std::string, int> _nodeIds;
+    QuadTree _nodeTree;
+
+    std::vector<EdgeEntry> _edges;
+    std::vector<int> _freeEdges;
+    std::unordered_map<Key, int> _edgeIds;
+    std::unordered_map<std::string, std::vector<int>> _incident;
+    QuadTree _edgeTree;
+
+    static QRectF circleRect(const QPointF &center, qreal radius);
+};
+
+#endif // HITINDEX_H
@@ -3,6 +3,8 @@
 
 #include "basis/headers/Node.h"
 #include <QGraphicsItem>
+#include <QStaticText>
+#include <QFont>
 
 class GraphGraphicsScene;
 
@@ -17,6 +19,11 @@ public:
 
     static QColor defaultOnSelectedColor();
 
+    static const QFont &labelFont();
+
+    // Diameter of the circle drawn for a node of this name
+    static int diameterFor(const std::string &name);
+
     enum {
         Type = UserType + 5
     };
@@ -27,6 +34,9 @@ public:
 
     GraphType::Node *node() const;
 
+    // Moves the item together with its node and notifies the attached edges
+    void moveTo(const QPointF &pos);
+
     int radius() const { return this->_radius; }
 
     QColor onSelectedColor() const;
@@ -39,6 +49,8 @@ public:
 
     QRectF boundingRect() const override;
 
+    bool contains(const QPointF &point) const override;
+
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
 
 signals:
@@ -52,15 +64,17 @@ private:
     QColor _selectedColor;
     GraphGraphicsScene *_gscene;
     bool _isMoving;
-    const int _fontSize = 10;
-    const QString _font = "Source Code Pro";
+    QStaticText _label;
+    QPointF _labelPos;
+
+    // Below these view scales the label is skipped and the node is drawn as a dot
+    static constexpr qreal _labelDetail = 0.45;
+    static constexpr qreal _shapeDetail = 0.2;
 
 protected:
     void mouseMoveEvent(QGraphicsSceneMouseEvent *event) override;
 
     void mouseReleaseEvent(QGraphicsSceneMouseEvent *event) override;
-
-    void hoverEnterEvent(QGraphicsSceneHoverEvent *event) override;
 };
 
 #endif // NODEGRAPHICSITEM_H
@@ -0,0 +1,15 @@
+#ifndef QTPOINT_H
+#define QTPOINT_H
+
+#include "basis/headers/Point.h"
+#include <QPointF>
+
+inline QPointF toQPointF(const GraphType::Point &point) {
+    return {point.x(), point.y()};
+}
+
+inline GraphType::Point toPoint(const QPointF &point) {
+    return {point.x(), point.y()};
+}
+
+#endif // QTPOINT_H
@@ -0,0 +1,71 @@
+#ifndef QUADTREE_H
+#define QUADTREE_H
+
+#include <QRectF>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Spatial index of integer ids by their scene rectangle.
+ * An entry lives in the smallest cell that fully contains it, cells split once
+ * they hold more than `capacity` entries and the root grows to fit new entries.
+ */
+class QuadTree {
+public:
+    explicit QuadTree(const QRectF &bounds = QRectF(-512, -512, 1024, 1024), int capacity = 16, int maxDepth = 16);
+
+    void insert(int id, const QRectF &rect);
+
+    bool remove(int id);
+
+    void update(int id, const QRectF &rect);
+
+    void clear();
+
+    bool contains(int id) const { return _rects.find(id) != _rects.end(); }
+
+    int size() const { return static_cast<int>(_rects.size()); }
+
+    QRectF bounds() const { return this->_root->bounds; }
+
+    void query(const QRectF &area, std::vector<int> &result) const;
+
+    std::vector<int> query(const QRectF &area) const;
+
+private:
+    struct Entry {
+        int id;
+        QRectF rect;
+    };
+
+    struct Cell {
+        QRectF bounds;
+        std::vector<Entry> entries;
+        std::unique_ptr<Cell> children[4];
+
+        explicit Cell(const QRectF &rect) : bounds(rect) {}
+
+        bool isLeaf() const { return !children[0]; }
+    };
+
+    std::unique_ptr<Cell> _root;
+    std::unordered_map<int, QRectF> _rects;
+    QRectF _initialBounds;
+    int _capacity;
+    int _maxDepth;
+
+    static int childIndex(const Cell *cell, const QRectF &rect);
+
+    void insert(Cell *cell, int depth, const Entry &entry);
+
+    bool remove(Cell *cell, int id, const QRectF &rect);
+
+    void split(Cell *cell, int depth);
+
+    void grow(const QRectF &rect);
+
+    static void query(const Cell *cell, const QRectF &area, std::vector<int> &result);
+};
+
+#endif // QUADTREE_H
@@ -0,0 +1,121 @@
+#ifndef TILECACHE_H
+#define TILECACHE_H
+
+#include "basis/headers/Graph.h"
+#include "QuadTree.h"
+#include <QObject>
+#include <QImage>
+#include <QColor>
+#include <QTimer>
+#include <QFutureWatcher>
+#include <QLineF>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class QPainter;
+
+/*
+ * Pre-rendered image tiles of the whole graph, one set per zoom level.
+ * Tiles are drawn on worker threads from an immutable snapshot of the graph
+ * geometry and dropped only where nodes or edges changed. After a change the
+ * cache is not ready until a new snapshot is built, the scene then paints its
+ * items as usual.
+ */
+class TileCache : public QObject {
+Q_OBJECT
+public:
+    struct Snapshot {
+        bool directed = false;
+        bool weighted = false;
+        QColor nodeColor;
+        QColor edgeColor;
+        int maxRadius = 0;
+        std::vector<QPointF> positions;
+        std::vector<int> radii;
+        std::vector<std::string> names;
+        std::unordered_map<std::string, int> ids;
+        std::vector<QLineF> lines;
+        std::vector<int> weights;
+        std::vector<std::pair<int, int>> ends;
+        std::vector<int> incidentStart;
+        std::vector<int> incident;
+        QuadTree nodeIndex;
+        QuadTree edgeIndex;
+    };
+
+    explicit TileCache(QObject *parent = nullptr);
+
+    void setGraph(GraphType::Graph *graph);
+
+    bool ready() const { return this->_ready; }
+
+    // Composites the tiles covering `rect`, the painter is in scene coordinates
+    void paint(QPainter *painter, const QRectF &rect);
+
+    void invalidate(const QRectF &rect);
+
+    void invalidateNode(const std::string &name);
+
+    void invalidateEdge(const std::string &uname, const std::string &vname);
+
+    static void draw(QPainter *painter, const Snapshot &snapshot, const QRectF &area, qreal scale);
+
+signals:
+
+    void readyChanged();
+
+private:
+    struct TileKey {
+        int level;
+        int x;
+        int y;
+
+        bool operator==(const TileKey &other) const {
+            return level == other.level && x == other.x && y == other.y;
+        }
+    };
+
+    struct TileKeyHash {
+        size_t operator()(const TileKey &key) const {
+            return std::hash<long long>()(((long long) key.level << 48) ^ ((long long) key.x << 24) ^ key.y);
+        }
+    };
+
+    struct Tile {
+        QImage image;
+        unsigned long lastUsed;
+    };
+
+    GraphType::Graph *_graph{};
+    bool _ready;
+    unsigned long _generation;
+    unsigned long _frame;
+    std::shared_ptr<const Snapshot> _snapshot;
+    std::unordered_map<TileKey, Tile, TileKeyHash> _tiles;
+    std::unordered_map<TileKey, unsigned long, TileKeyHash> _pending;
+    QFutureWatcher<std::shared_ptr<const Snapshot>> _snapshotWatcher;
+    QTimer _rebuildTimer;
+
+    static constexpr int _tileSize = 256;
+    static constexpr int _maxTiles = 256;
+
+    static qreal levelScale(int level);
+
+    static QRectF tileRect(const TileKey &key);
+
+    void rebuild();
+
+    void requestTile(const TileKey &key);
+
+    void evict();
+
+    void markStale();
+
+    static std::shared_ptr<const Snapshot> buildSnapshot(std::shared_ptr<Snapshot> snapshot);
+
+    static QImage renderTile(std::shared_ptr<const Snapshot> snapshot, QRectF area, qreal scale);
+};
+
+#endif // TILECACHE_H
@@ -14,25 +14,24 @@ EdgeGraphicsItem::EdgeGraphicsItem(GraphGraphicsScene *scene, NodeGraphicsItem *
     this->_gscene = scene;
     this->_color = std::move(baseColor);
     setFlag(QGraphicsItem::ItemIsSelectable, true);
-    setAcceptHoverEvents(true);
     setPen(QPen(this->_color, 2, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
     this->_onSelectedColor = colorTable()[1];
 
-    updatePosition();
+    updateGeometry();
     connect(startItem, SIGNAL(positionChanged()), SLOT(updatePosition()));
     connect(endItem, SIGNAL(positionChanged()), SLOT(updatePosition()));
-    emit _gscene->needRedraw();
 }
 
 const QList<QColor> &EdgeGraphicsItem::colorTable() {
-    static QList<QColor> colorTable;
-    colorTable.append(QColor(57, 89, 119));
-    colorTable.append(QColor(205, 92, 92));
-    colorTable.append(QColor(57, 89, 119));
-    colorTable.append(QColor(85, 107, 47));
-    colorTable.append(QColor(47, 79, 79));
-    colorTable.append(QColor(119, 136, 153));
-    colorTable.append(QColor(112, 128, 144));
+    static const QList<QColor> colorTable = {
+            QColor(57, 89, 119),
+            QColor(205, 92, 92),
+            QColor(57, 89, 119),
+            QColor(85, 107, 47),
+            QColor(47, 79, 79),
+            QColor(119, 136, 153),
+            QColor(112, 128, 144)
+    };
     return colorTable;
 };
 
@@ -45,11 +44,28 @@ QRectF EdgeGraphicsItem::boundingRect() const {
     return QRectF(line().p1(), QSizeF(line().p2().x() - line().p1().x(),
                                       line().p2().y() - line().p1().y()))
             .normalized()
+            .united(_shape.controlPointRect())
             .adjusted(-extra, -extra, extra, extra);
 }
 
 QPainterPath EdgeGraphicsItem::shape() const {
-    return this->_path;
+    return this->_shape;
+}
+
+bool EdgeGraphicsItem::contains(const QPointF &point) const {
+    // Two segments through the bend stand in for the stroked curve
+    return HitIndex::distance(point, QLineF(line().p1(), _bend)) <= _hitTolerance
+           || HitIndex::distance(point, QLineF(_bend, line().p2())) <= _hitTolerance
+           || _weightRect.contains(point);
+}
+
+const QFont &EdgeGraphicsItem::weightFont() {
+    static const QFont font = []() {
+        QFont font;
+        font.setPointSize(13);
+        return font;
+    }();
+    return font;
 }
 
 GraphType::Edge EdgeGraphicsItem::edge() const {
@@ -61,6 +77,25 @@ int EdgeGraphicsItem::weight() const {
 }
 
 void EdgeGraphicsItem::updatePosition() {
+    if (!geometryChanged())
+        return;
+    updateGeometry();
+    _gscene->requestRedraw();
+}
+
+bool EdgeGraphicsItem::geometryChanged() const {
+    auto graph = _gscene->graph();
+    return _startItem->pos() != _startPos || _endItem->pos() != _endPos
+           || (graph->isWeighted() && weight() != _weight)
+           || (graph->isDirected() && inversionAvailable() != _inverted);
+}
+
+void EdgeGraphicsItem::updateGeometry() {
+    prepareGeometryChange();
+    this->_startPos = _startItem->pos();
+    this->_endPos = _endItem->pos();
+    this->_weight = _gscene->graph()->isWeighted() ? weight() : 0;
+    this->_inverted = _gscene->graph()->isDirected() && inversionAvailable();
     qreal p = _startItem->pos().x();
     qreal q = _startItem->pos().y();
     qreal r = _endItem->pos().x();
@@ -87,7 +122,7 @@ void EdgeGraphicsItem::updatePosition() {
                 (1 - ty1) * p + ty1 * r,
                 (1 - ty1) * q + ty1 * s);
     }
-    if (_gscene->graph()->isDirected() && inversionAvailable()) {
+    if (_inverted) {
         qreal offset = arrowHeadSize / 2;
         qreal foo = qMax(5., qMin(25., length / 6));
         if (edge().u()->name() < edge().v()->name()) {
@@ -117,13 +152,21 @@ void EdgeGraphicsItem::updatePosition() {
         arrowHead << arrowHeadPoint << arrowP2 << arrowP1;
         this->_path.addPolygon(arrowHead);
     }
+    this->_shape = _path;
+    this->_bend = _inverted ? centerPos : line().center();
+    this->_weightRect = QRectF();
     if (_gscene->graph()->isWeighted()) {
-        QFont font;
-        font.setPointSize(13);
-        auto textPos = centerPos;
-        this->_path.addText(textPos, font, QString::number(this->weight()));
+        QString text = QString::number(this->weight());
+        if (_weightLabel.text() != text) {
+            this->_weightLabel.setText(text);
+            this->_weightLabel.setTextFormat(Qt::PlainText);
+            this->_weightLabel.prepare(QTransform(), weightFont());
+        }
+        QFontMetricsF fm(weightFont());
+        this->_weightPos = centerPos - QPointF(0, fm.ascent());
+        this->_weightRect = QRectF(_weightPos, _weightLabel.size());
+        this->_shape.addRect(_weightRect);
     }
-    emit _gscene->needRedraw();
 }
 
 void EdgeGraphicsItem::setOnSelectedColor(QColor newColor) {
@@ -136,10 +179,12 @@ bool EdgeGraphicsItem::inversionAvailable() const {
 
 void EdgeGraphicsItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
                              QWidget *widget) {
-    Q_UNUSED(option);
     Q_UNUSED(widget);
     if (_startItem->collidesWithItem(_endItem))
         return;
+    // The background tiles already show the edge in its plain state
+    if (_gscene->tilesActive() && !isSelected())
+        return;
 
     painter->setTransform(transform(), true);
     //updatePosition();
@@ -148,16 +193,22 @@ void EdgeGraphicsItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *
     else
         _color = defaultColor();
 
+    qreal detail = option->levelOfDetailFromTransform(painter->worldTransform());
+    if (detail < _lineDetail) {
+        painter->setPen(QPen(_color, 0));
+        painter->drawLine(line());
+        return;
+    }
     QPen myPen = pen();
     myPen.setColor(_color);
     myPen.setWidth(4);
     painter->setBrush(_color);
     painter->setPen(myPen);
-    painter->drawPath(this->shape());
-}
+    painter->drawPath(this->_path);
 
-void EdgeGraphicsItem::hoverEnterEvent(QGraphicsSceneHoverEvent *event) {
-    QGraphicsItem::hoverEnterEvent(event);
-    setCursor(Qt::PointingHandCursor);
+    if (_gscene->graph()->isWeighted() && detail >= _weightDetail) {
+        painter->setFont(weightFont());
+        painter->drawStaticText(_weightPos, _weightLabel);
+    }
 }
 
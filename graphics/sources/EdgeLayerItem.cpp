@@ -0,0 +1,213 @@
+#include "graphics/headers/EdgeLayerItem.h"
+#include "graphics/headers/GraphGraphicsScene.h"
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <qmath.h>
+#include <algorithm>
+
+EdgeLayerItem::EdgeLayerItem(GraphGraphicsScene *scene) {
+    this->_gscene = scene;
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);
+    setAcceptedMouseButtons(Qt::NoButton);
+}
+
+QRectF EdgeLayerItem::lineRect(const QLineF &line) {
+    return QRectF(line.p1(), line.p2()).normalized();
+}
+
+QRectF EdgeLayerItem::boundingRect() const {
+    return this->_bounds;
+}
+
+QPainterPath EdgeLayerItem::shape() const {
+    // Only single points hit the layer (see contains), rubber bands and collisions ignore it
+    return QPainterPath();
+}
+
+bool EdgeLayerItem::contains(const QPointF &point) const {
+    Key key;
+    return edgeAt(point, key);
+}
+
+void EdgeLayerItem::place(int id, const QLineF &line) {
+    QRectF rect = lineRect(line).adjusted(-_margin, -_margin, _margin, _margin);
+    if (!_bounds.contains(rect)) {
+        prepareGeometryChange();
+        this->_bounds = _bounds.united(rect);
+    }
+    update(lineRect(_lines[id]).adjusted(-_margin, -_margin, _margin, _margin));
+    this->_lines[id] = line;
+    this->_index.insert(id, lineRect(line));
+    update(rect);
+}
+
+void EdgeLayerItem::setEdge(const Key &key, const QPointF &p1, const QPointF &p2, int weight) {
+    auto it = _ids.find(key);
+    int id;
+    if (it != _ids.end()) {
+        id = it->second;
+    } else {
+        if (!_free.empty()) {
+            id = _free.back();
+            _free.pop_back();
+        } else {
+            id = static_cast<int>(_lines.size());
+            _lines.emplace_back(p1, p2);
+            _weights.push_back(0);
+            _flags.push_back(0);
+            _keys.emplace_back();
+        }
+        _flags[id] = Alive;
+        _keys[id] = key;
+        _ids[key] = id;
+        _incident[key.first].push_back(id);
+        _incident[key.second].push_back(id);
+    }
+    this->_weights[id] = weight;
+    place(id, QLineF(p1, p2));
+}
+
+bool EdgeLayerItem::removeEdge(const Key &key) {
+    auto it = _ids.find(key);
+    if (it == _ids.end())
+        return false;
+    int id = it->second;
+    _ids.erase(it);
+    for (const auto &name: {key.first, key.second}) {
+        auto &ids = _incident[name];
+        ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+        if (ids.empty())
+            _incident.erase(name);
+    }
+    _index.remove(id);
+    _flags[id] = 0;
+    _free.push_back(id);
+    update(lineRect(_lines[id]).adjusted(-_margin, -_margin, _margin, _margin));
+    return true;
+}
+
+void EdgeLayerItem::setHidden(const Key &key, bool hidden) {
+    auto it = _ids.find(key);
+    if (it == _ids.end())
+        return;
+    int id = it->second;
+    if (hidden)
+        _flags[id] |= Hidden;
+    else
+        _flags[id] &= ~Hidden;
+    update(lineRect(_lines[id]).adjusted(-_margin, -_margin, _margin, _margin));
+}
+
+void EdgeLayerItem::moveNode(const std::string &name, const QPointF &pos) {
+    auto it = _incident.find(name);
+    if (it == _incident.end())
+        return;
+    for (int id: it->second) {
+        QLineF line = _lines[id];
+        if (_keys[id].first == name)
+            line.setP1(pos);
+        else
+            line.setP2(pos);
+        place(id, line);
+    }
+}
+
+void EdgeLayerItem::removeNode(const std::string &name) {
+    auto it = _incident.find(name);
+    if (it == _incident.end())
+        return;
+    auto ids = it->second;
+    for (int id: ids) {
+        auto key = _keys[id];
+        removeEdge(key);
+    }
+}
+
+void EdgeLayerItem::clear() {
+    prepareGeometryChange();
+    this->_lines.clear();
+    this->_weights.clear();
+    this->_flags.clear();
+    this->_keys.clear();
+    this->_free.clear();
+    this->_ids.clear();
+    this->_incident.clear();
+    this->_index.clear();
+    this->_bounds = QRectF();
+}
+
+bool EdgeLayerItem::edgeAt(const QPointF &point, Key &key, qreal tolerance) const {
+    QRectF area(point.x() - tolerance, point.y() - tolerance, tolerance * 2, tolerance * 2);
+    qreal best = tolerance;
+    int found = -1;
+    for (int id: _index.query(area)) {
+        if (_flags[id] & Hidden)
+            continue;
+        const QLineF &line = _lines[id];
+        QPointF d = line.p2() - line.p1();
+        qreal length = d.x() * d.x() + d.y() * d.y();
+        qreal t = length > 0 ? QPointF::dotProduct(point - line.p1(), d) / length : 0;
+        t = std::max<qreal>(0, std::min<qreal>(1, t));
+        qreal distance = QLineF(point, line.p1() + d * t).length();
+        if (distance <= best) {
+            best = distance;
+            found = id;
+        }
+    }
+    if (found < 0)
+        return false;
+    key = _keys[found];
+    return true;
+}
+
+void EdgeLayerItem::appendArrowHead(const QLineF &line, std::vector<QLineF> &heads) {
+    if (line.length() <= 0)
+        return;
+    QPointF unit = (line.p1() - line.p2()) / line.length();
+    QPointF tip = line.p2() + unit * 40;
+    QLineF side(tip, tip + unit * 15);
+    side.setAngle(side.angle() + 30);
+    heads.push_back(side);
+    side.setAngle(side.angle() - 60);
+    heads.push_back(side);
+}
+
+void EdgeLayerItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) {
+    Q_UNUSED(widget);
+    if (_gscene->tilesActive())
+        return;
+    qreal detail = option->levelOfDetailFromTransform(painter->worldTransform());
+    std::vector<int> visible;
+    _index.query(option->exposedRect.adjusted(-_margin, -_margin, _margin, _margin), visible);
+
+    bool arrows = _gscene->graph()->isDirected() && detail >= _arrowDetail;
+    std::vector<QLineF> bodies, heads;
+    bodies.reserve(visible.size());
+    if (arrows)
+        heads.reserve(visible.size() * 2);
+    for (int id: visible) {
+        if (_flags[id] & Hidden)
+            continue;
+        const QLineF &line = _lines[id];
+        bodies.push_back(line);
+        if (arrows)
+            appendArrowHead(line, heads);
+    }
+
+    QColor color = EdgeGraphicsItem::defaultColor();
+    painter->setPen(QPen(color, detail < _arrowDetail ? 0 : 2));
+    painter->drawLines(bodies.data(), static_cast<int>(bodies.size()));
+    if (!heads.empty()) {
+        painter->setPen(QPen(color, 3, Qt::SolidLine, Qt::RoundCap));
+        painter->drawLines(heads.data(), static_cast<int>(heads.size()));
+    }
+
+    if (_gscene->graph()->isWeighted() && detail >= _weightDetail && static_cast<int>(bodies.size()) <= _weightLimit) {
+        QFont font;
+        font.setPointSize(13);
+        painter->setFont(font);
+        for (int id: visible)
+            if (!(_flags[id] & Hidden))
+                painter->drawText(_lines[id].center(), QString::number(_weights[id]));
+    }
+}
@@ -1,15 +1,48 @@
 #include "graphics/headers/GraphGraphicsScene.h"
+#include "graphics/headers/QtPoint.h"
 #include "utils/random.h"
 #include <QDebug>
 #include <memory>
+#include <unordered_set>
 #include <utility>
 
-GraphGraphicsScene::GraphGraphicsScene() = default;
+GraphGraphicsScene::GraphGraphicsScene() {
+    this->_tiles = new TileCache(this);
+    connect(_tiles, &TileCache::readyChanged, this, [this]() {
+        if (_tiledRendering)
+            this->update();
+    });
+    _redrawTimer.setSingleShot(true);
+    _redrawTimer.setInterval(16);
+    connect(&_redrawTimer, &QTimer::timeout, this, &GraphGraphicsScene::needRedraw);
+    _demoTimer.setInterval(16);
+    connect(&_demoTimer, &QTimer::timeout, this, &GraphGraphicsScene::advanceDemo);
+    _animation.setStartValue(0.);
+    _animation.setEndValue(1.);
+    _animation.setEasingCurve(QEasingCurve::InOutCubic);
+    connect(&_animation, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
+        // Node pointers may be stale once nodes were added or removed
+        if (_graph == nullptr || _graph->version() != _animationVersion) {
+            _animation.stop();
+            return;
+        }
+        qreal t = value.toReal();
+        std::vector<QPointF> positions(_animatedNodes.size());
+        for (size_t i = 0; i < positions.size(); ++i)
+            positions[i] = _animationFrom[i] + (_animationTo[i] - _animationFrom[i]) * t;
+        moveNodes(_animatedNodes, positions);
+    });
+}
 
-GraphGraphicsScene::GraphGraphicsScene(GraphType::Graph *graph) {
+GraphGraphicsScene::GraphGraphicsScene(GraphType::Graph *graph) : GraphGraphicsScene() {
     setGraph(graph);
 }
 
+void GraphGraphicsScene::requestRedraw() {
+    if (!_redrawTimer.isActive())
+        _redrawTimer.start();
+}
+
 GraphType::Graph *GraphGraphicsScene::graph() const {
     return this->_graph;
 }
@@ -21,198 +54,735 @@ void GraphGraphicsScene::setGraph(GraphType::Graph *graph) {
 
 void GraphGraphicsScene::reload() {
     this->clearAll();
+    if (_autoVirtualized)
+        this->_virtualized = graph()->countNodes() > _virtualizedThreshold;
+    if (_autoBatchedEdges)
+        this->_batchedEdges = graph()->countEdges() > _batchedEdgesThreshold;
+    if (_autoTiledRendering)
+        this->_tiledRendering = _batchedEdges || _virtualized;
+    _tiles->setGraph(_tiledRendering ? graph() : nullptr);
+    if (_batchedEdges || _virtualized) {
+        this->_edgeLayer = new EdgeLayerItem(this);
+        this->addItem(_edgeLayer);
+    }
     for (const auto &node: graph()->nodeList())
-        _nodeItems[node->name()] = new NodeGraphicsItem(this, node);
-    for (auto it = graph()->edgeSet().begin(); it != graph()->edgeSet().end(); ++it) {
-        auto edge = GraphType::Edge(it);
-        _edgeItems.insert({std::make_pair(edge.u()->name(), edge.v()->name()),
-                           new EdgeGraphicsItem(this,
-                                                _nodeItems[edge.u()->name()],
-                                                _nodeItems[edge.v()->name()])
-                          });
+        _hits.setNode(node->name(), toQPointF(node->euclidePos()), NodeGraphicsItem::diameterFor(node->name()) / 2.);
+    if (_virtualized) {
+        for (const auto &node: graph()->nodeList())
+            indexNode(node);
+        setSceneRect(_nodeBounds.adjusted(-_virtualMargin, -_virtualMargin, _virtualMargin, _virtualMargin));
+    } else {
+        setSceneRect(QRectF());
+        for (const auto &node: graph()->nodeList())
+            addNodeItem(node);
     }
-    for (const auto &item: _edgeItems)
-        this->addItem(item.second);
-    for (const auto &item: _nodeItems)
-        this->addItem(item.second);
+    for (const auto &it: graph()->edgeSet())
+        createEdgeItem(it.first);
+    materialize();
+    restoreDemoEdges();
     this->update();
 }
 
-void GraphGraphicsScene::demoAlgorithm(const std::list<std::pair<std::string, std::string>> &listOfPairToDemo,
-                                       GraphDemoFlag flag) {
-    resetAfterDemoAlgo();
-    _listOfPair = listOfPairToDemo;
-    _uniqueTimer = std::make_unique<QTimer>();
-    if (flag == GraphDemoFlag::Coloring) {
-        std::map<std::string, QColor> colorMap;
-        std::set<std::string> colorCodes;
-        auto random = Random();
-        for (auto &it: _listOfPair)
-            colorCodes.insert(it.second);
-        for (auto &code: colorCodes)
-            colorMap[code] = QColor(random.drawNumber(0, 255), random.drawNumber(0, 255), random.drawNumber(0, 255));
-        connect(_uniqueTimer.get(), &QTimer::timeout, this, [this, colorMap]() {
-            if (!this->_listOfPair.empty()) {
-                auto nodeItem = this->nodeItem(this->_listOfPair.front().first);
-                auto color_code = this->_listOfPair.front().second;
-                this->_listOfPair.pop_front();
-                if (nodeItem != nullptr) {
-                    auto color = colorMap.find(color_code)->second;
-                    nodeItem->setOnSelectedColor(color);
-                    nodeItem->setSelected(true);
-                }
-                this->update();
-            } else {
-                _uniqueTimer->stop();
-                this->_listOfPair.clear();
-            }
-        });
+void GraphGraphicsScene::setVirtualized(bool enabled) {
+    this->_autoVirtualized = false;
+    if (enabled == _virtualized)
+        return;
+    this->_virtualized = enabled;
+    reload();
+}
+
+void GraphGraphicsScene::setTiledRendering(bool enabled) {
+    this->_autoTiledRendering = false;
+    if (enabled == _tiledRendering)
+        return;
+    this->_tiledRendering = enabled;
+    _tiles->setGraph(enabled ? graph() : nullptr);
+    this->update();
+}
+
+void GraphGraphicsScene::moveNodes(const std::vector<GraphType::Node *> &nodes,
+                                   const std::vector<QPointF> &positions) {
+    this->_bulkMove = true;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        auto name = nodes[i]->name();
+        auto item = nodeItem(name);
+        if (item != nullptr) {
+            item->moveTo(positions[i]);
+            continue;
+        }
+        _graph->setNodePos(nodes[i], toPoint(positions[i]));
+        if (_edgeLayer != nullptr)
+            _edgeLayer->moveNode(name, positions[i]);
+        if (_virtualized)
+            moveIndexedNode(name, positions[i]);
+        _hits.moveNode(name, positions[i]);
+    }
+    this->_bulkMove = false;
+    // Invalidating tile by tile costs more than starting over
+    if (_tiledRendering)
+        _tiles->setGraph(_graph);
+    if (_virtualized) {
+        this->_nodeBounds = QRectF();
+        for (const auto &pos: _positions)
+            this->_nodeBounds = _nodeBounds.united(QRectF(pos, QSizeF(1, 1)));
+        setSceneRect(_nodeBounds.adjusted(-_virtualMargin, -_virtualMargin, _virtualMargin, _virtualMargin));
+        materialize();
+    }
+    requestRedraw();
+}
+
+void GraphGraphicsScene::animateNodes(const std::vector<GraphType::Node *> &nodes,
+                                      const std::vector<QPointF> &positions, int duration) {
+    _animation.stop();
+    this->_animatedNodes = nodes;
+    this->_animationTo = positions;
+    this->_animationFrom.resize(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i)
+        this->_animationFrom[i] = toQPointF(nodes[i]->euclidePos());
+    this->_animationVersion = _graph->version();
+    _animation.setDuration(duration);
+    _animation.start();
+}
+
+void GraphGraphicsScene::setVisibleRect(const QRectF &rect) {
+    this->_visibleRect = rect;
+    materialize();
+}
+
+void GraphGraphicsScene::indexNode(GraphType::Node *node) {
+    int id = static_cast<int>(_virtualNodes.size());
+    QPointF pos = toQPointF(node->euclidePos());
+    _virtualNodes.push_back(node);
+    _positions.push_back(pos);
+    _virtualIds[node->name()] = id;
+    _nodeIndex.insert(id, QRectF(pos, pos));
+    this->_nodeBounds = _nodeBounds.united(QRectF(pos, QSizeF(1, 1)));
+}
+
+void GraphGraphicsScene::unindexNode(const std::string &name) {
+    auto it = _virtualIds.find(name);
+    if (it == _virtualIds.end())
+        return;
+    int id = it->second, last = static_cast<int>(_virtualNodes.size()) - 1;
+    _virtualIds.erase(it);
+    _nodeIndex.remove(id);
+    if (id != last) {
+        // Move the last node into the freed slot to keep the arrays dense
+        _nodeIndex.remove(last);
+        _virtualNodes[id] = _virtualNodes[last];
+        _positions[id] = _positions[last];
+        _virtualIds[_virtualNodes[id]->name()] = id;
+        _nodeIndex.insert(id, QRectF(_positions[id], _positions[id]));
+    }
+    _virtualNodes.pop_back();
+    _positions.pop_back();
+}
+
+void GraphGraphicsScene::moveIndexedNode(const std::string &name, const QPointF &pos) {
+    auto it = _virtualIds.find(name);
+    if (it == _virtualIds.end())
+        return;
+    _positions[it->second] = pos;
+    _nodeIndex.update(it->second, QRectF(pos, pos));
+}
+
+void GraphGraphicsScene::materialize() {
+    if (!_virtualized || _visibleRect.isEmpty())
+        return;
+    qreal dx = _visibleRect.width() / 2, dy = _visibleRect.height() / 2;
+    std::vector<int> ids;
+    _nodeIndex.query(_visibleRect.adjusted(-dx, -dy, dx, dy), ids);
+    bool collapsed = static_cast<int>(ids.size()) > _materializeLimit;
+    if (collapsed != _nodesCollapsed) {
+        this->_nodesCollapsed = collapsed;
+        this->update();
+    }
+    std::unordered_set<std::string> wanted;
+    if (!collapsed)
+        for (int id: ids)
+            wanted.insert(_virtualNodes[id]->name());
+    std::list<std::string> gone;
+    for (const auto &it: _nodeItems)
+        if (wanted.find(it.first) == wanted.end() && it.second != mouseGrabberItem())
+            gone.push_back(it.first);
+    for (const auto &name: gone)
+        releaseNodeItem(name);
+    if (collapsed)
+        return;
+    bool added = false;
+    for (int id: ids)
+        if (_nodeItems.find(_virtualNodes[id]->name()) == _nodeItems.end()) {
+            addNodeItem(_virtualNodes[id]);
+            added = true;
+        }
+    if (added)
+        restoreDemoEdges();
+}
+
+void GraphGraphicsScene::releaseNodeItem(const std::string &name) {
+    auto it = _nodeItems.find(name);
+    if (it == _nodeItems.end())
+        return;
+    auto item = it->second;
+    _nodeItems.erase(it);
+    // Promoted edges hold on to the item, put them back into the layer
+    std::list<std::pair<std::string, std::string>> keys;
+    for (const auto &edge: _edgeItems)
+        if (edge.first.first == name || edge.first.second == name)
+            keys.push_back(edge.first);
+    for (const auto &key: keys) {
+        if (_edgeLayer != nullptr)
+            _edgeLayer->setHidden(key, false);
+        delete _edgeItems[key];
+        _edgeItems.erase(key);
+    }
+    item->setSelected(false);
+    item->setOnSelectedColor(NodeGraphicsItem::defaultOnSelectedColor());
+    this->removeItem(item);
+    _nodePool.push_back(item);
+}
+
+void GraphGraphicsScene::drawBackground(QPainter *painter, const QRectF &rect) {
+    QGraphicsScene::drawBackground(painter, rect);
+    if (tilesActive())
+        _tiles->paint(painter, rect);
+}
+
+void GraphGraphicsScene::drawForeground(QPainter *painter, const QRectF &rect) {
+    QGraphicsScene::drawForeground(painter, rect);
+    if (!_virtualized || !_nodesCollapsed || tilesActive())
+        return;
+    // Too many nodes in sight for items, draw them as dots straight from the index
+    std::vector<int> ids;
+    _nodeIndex.query(rect.adjusted(-40, -40, 40, 40), ids);
+    std::vector<QRectF> dots;
+    dots.reserve(ids.size());
+    for (int id: ids)
+        dots.emplace_back(_positions[id] - QPointF(40, 40), QSizeF(80, 80));
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(NodeGraphicsItem::defaultColor());
+    painter->drawRects(dots.data(), static_cast<int>(dots.size()));
+}
+
+void GraphGraphicsScene::setBatchedEdges(bool enabled) {
+    this->_autoBatchedEdges = false;
+    if (enabled == _batchedEdges)
+        return;
+    this->_batchedEdges = enabled;
+    reload();
+}
+
+NodeGraphicsItem *GraphGraphicsScene::addNodeItem(GraphType::Node *node) {
+    NodeGraphicsItem *item;
+    if (!_nodePool.empty()) {
+        item = _nodePool.back();
+        _nodePool.pop_back();
+        item->setNode(node);
     } else {
-        connect(_uniqueTimer.get(), &QTimer::timeout, this, [this, flag]() {
-            if (!this->_listOfPair.empty()) {
-                auto startItem = this->nodeItem(this->_listOfPair.front().first);
-                auto endItem = this->nodeItem(this->_listOfPair.front().second);
-                auto edgeItem = this->edgeItem(this->_listOfPair.front().first, this->_listOfPair.front().second);
-
-                if (flag == GraphDemoFlag::EdgeAndNode) {
-                    if (startItem != nullptr)
-                        startItem->setSelected(true);
-                    if (edgeItem != nullptr)
-                        edgeItem->setSelected(true);
-                    if (endItem != nullptr)
-                        endItem->setSelected(true);
-                } else if (flag == GraphDemoFlag::OnlyEdge) {
-                    if (edgeItem != nullptr)
-                        edgeItem->setSelected(true);
-                } else if (flag == GraphDemoFlag::OnlyNode) {
-                    if (startItem != nullptr)
-                        startItem->setSelected(true);
-                    if (endItem != nullptr)
-                        endItem->setSelected(true);
-                }
-                this->update();
-                this->_listOfPair.pop_front();
-            } else {
-                _uniqueTimer->stop();
-                this->_listOfPair.clear();
-            }
+        item = new NodeGraphicsItem(this, node);
+        connect(item, &NodeGraphicsItem::positionChanged, this, [this, item]() {
+            if (_edgeLayer != nullptr)
+                _edgeLayer->moveNode(item->node()->name(), item->pos());
+            if (_virtualized)
+                moveIndexedNode(item->node()->name(), item->pos());
+            if (_tiledRendering && !_bulkMove)
+                _tiles->invalidateNode(item->node()->name());
+            _hits.moveNode(item->node()->name(), item->pos());
         });
     }
-    _uniqueTimer->start(_interval);
+    _nodeItems[node->name()] = item;
+    this->addItem(item);
+    auto state = _demoNodeStates.find(node->name());
+    if (state != _demoNodeStates.end())
+        applyDemoState(item, state->second);
+    return item;
 }
 
-void GraphGraphicsScene::demoAlgorithm(const std::list<std::string> &listOfNodeToDemo, GraphDemoFlag flag) {
-    resetAfterDemoAlgo();
-    this->_listOfNode = listOfNodeToDemo;
-    _uniqueTimer = std::make_unique<QTimer>();
-    connect(_uniqueTimer.get(), &QTimer::timeout, this, [this, flag]() {
-        if (!this->_listOfNode.empty()) {
-            auto start_name = this->_listOfNode.front();
-            this->_listOfNode.pop_front();
-            auto end_name = !this->_listOfNode.empty() ? this->_listOfNode.front() : "";
-
-            auto startItem = this->nodeItem(start_name);
-            auto endItem = this->nodeItem(end_name);
-            auto edgeItem = this->edgeItem(start_name, end_name);
-            if (flag == GraphDemoFlag::EdgeAndNode) {
-                if (startItem != nullptr)
-                    startItem->setSelected(true);
-                if (edgeItem != nullptr)
-                    edgeItem->setSelected(true);
-                if (endItem != nullptr)
-                    endItem->setSelected(true);
-            } else if (flag == GraphDemoFlag::OnlyNode) {
-                if (startItem != nullptr)
-                    startItem->setSelected(true);
-            }
-            this->update();
-        } else {
-            this->_uniqueTimer->stop();
-            this->_listOfNode.clear();
+EdgeGraphicsItem *GraphGraphicsScene::createEdgeItem(const GraphType::NodePair &pair) {
+    _hits.setEdge(std::make_pair(pair.first->name(), pair.second->name()),
+                  toQPointF(pair.first->euclidePos()), toQPointF(pair.second->euclidePos()));
+    if (_edgeLayer != nullptr) {
+        // Node items may not exist in the virtualized mode, positions come from the graph
+        _edgeLayer->setEdge(std::make_pair(pair.first->name(), pair.second->name()),
+                            toQPointF(pair.first->euclidePos()), toQPointF(pair.second->euclidePos()), _graph->edgeSet().at(pair));
+        return nullptr;
+    }
+    auto startItem = nodeItem(pair.first->name());
+    auto endItem = nodeItem(pair.second->name());
+    if (startItem == nullptr || endItem == nullptr)
+        return nullptr;
+    auto item = new EdgeGraphicsItem(this, startItem, endItem);
+    _edgeItems[std::make_pair(pair.first->name(), pair.second->name())] = item;
+    this->addItem(item);
+    return item;
+}
+
+EdgeGraphicsItem *GraphGraphicsScene::promoteEdge(const std::string &uname, const std::string &vname) {
+    auto key = std::make_pair(uname, vname);
+    if (!_edgeLayer->hasEdge(key) && _graph->isUndirected())
+        key = std::make_pair(vname, uname);
+    if (!_edgeLayer->hasEdge(key))
+        return nullptr;
+    auto startItem = nodeItem(key.first);
+    auto endItem = nodeItem(key.second);
+    if (startItem == nullptr || endItem == nullptr)
+        return nullptr;
+    auto item = new EdgeGraphicsItem(this, startItem, endItem);
+    _edgeItems[key] = item;
+    this->addItem(item);
+    _edgeLayer->setHidden(key, true);
+    return item;
+}
+
+void GraphGraphicsScene::demoteEdges() {
+    if (_edgeLayer == nullptr)
+        return;
+    for (const auto &it: _edgeItems) {
+        _edgeLayer->setHidden(it.first, false);
+        delete it.second;
+    }
+    _edgeItems.clear();
+}
+
+EdgeGraphicsItem *GraphGraphicsScene::edgeItemAt(const QPointF &scenePos) {
+    EdgeLayerItem::Key key;
+    if (_edgeLayer == nullptr || !_edgeLayer->edgeAt(scenePos, key))
+        return nullptr;
+    return promoteEdge(key.first, key.second);
+}
+
+QGraphicsItem *GraphGraphicsScene::hitItem(const QPointF &scenePos) {
+    std::string name;
+    if (_hits.nodeAt(scenePos, name)) {
+        auto item = nodeItem(name);
+        if (item == nullptr && _graph->node(name) != nullptr)
+            item = addNodeItem(_graph->node(name));
+        return item;
+    }
+    HitIndex::Key key;
+    if (_hits.edgeAt(scenePos, key))
+        return edgeItem(key.first, key.second);
+    return nullptr;
+}
+
+QList<QGraphicsItem *> GraphGraphicsScene::hitItems(const QRectF &sceneRect) {
+    QList<QGraphicsItem *> result;
+    std::vector<std::string> names;
+    _hits.nodesIn(sceneRect, names);
+    for (const auto &name: names) {
+        auto item = nodeItem(name);
+        if (item == nullptr && _graph->node(name) != nullptr)
+            item = addNodeItem(_graph->node(name));
+        if (item != nullptr)
+            result.push_back(item);
+    }
+    std::vector<HitIndex::Key> keys;
+    _hits.edgesIn(sceneRect, keys);
+    for (const auto &key: keys) {
+        auto item = edgeItem(key.first, key.second);
+        if (item != nullptr)
+            result.push_back(item);
+    }
+    return result;
+}
+
+bool GraphGraphicsScene::isHit(const QPointF &scenePos) const {
+    std::string name;
+    HitIndex::Key key;
+    return _hits.nodeAt(scenePos, name) || _hits.edgeAt(scenePos, key);
+}
+
+void GraphGraphicsScene::removeEdgeItem(const std::pair<std::string, std::string> &key) {
+    _hits.removeEdge(key);
+    if (_edgeLayer != nullptr)
+        _edgeLayer->removeEdge(key);
+    auto it = _edgeItems.find(key);
+    if (it == _edgeItems.end())
+        return;
+    delete it->second;
+    _edgeItems.erase(it);
+}
+
+void GraphGraphicsScene::removeIncidentEdgeItems(const std::string &name) {
+    std::list<std::pair<std::string, std::string>> keys;
+    for (const auto &item: _edgeItems)
+        if (item.first.first == name || item.first.second == name)
+            keys.push_back(item.first);
+    for (const auto &key: keys)
+        removeEdgeItem(key);
+    _hits.removeIncidentEdges(name);
+    if (_edgeLayer != nullptr)
+        _edgeLayer->removeNode(name);
+}
+
+void GraphGraphicsScene::updateReverseEdgeItem(const std::string &uname, const std::string &vname) {
+    auto it = _edgeItems.find(std::make_pair(vname, uname));
+    if (it != _edgeItems.end())
+        it->second->updatePosition();
+}
+
+void GraphGraphicsScene::nodeAdded(const std::string &name) {
+    auto node = _graph->node(name);
+    if (node == nullptr || nodeItem(name) != nullptr || _virtualIds.find(name) != _virtualIds.end())
+        return;
+    _hits.setNode(name, toQPointF(node->euclidePos()), NodeGraphicsItem::diameterFor(name) / 2.);
+    if (_virtualized) {
+        indexNode(node);
+        setSceneRect(sceneRect().united(QRectF(toQPointF(node->euclidePos()), QSizeF(1, 1))));
+        if (!_nodesCollapsed && _visibleRect.contains(toQPointF(node->euclidePos())))
+            addNodeItem(node);
+    } else
+        addNodeItem(node);
+    // A renamed node is re-added together with its edges
+    if (node->undirDegree() == 0 && node->dirDegree() == 0)
+        return;
+    for (const auto &it: _graph->edgeSet())
+        if (it.first.first == node || it.first.second == node)
+            createEdgeItem(it.first);
+}
+
+void GraphGraphicsScene::nodeRemoved(const std::string &name) {
+    removeIncidentEdgeItems(name);
+    _hits.removeNode(name);
+    unindexNode(name);
+    auto it = _nodeItems.find(name);
+    if (it == _nodeItems.end())
+        return;
+    delete it->second;
+    _nodeItems.erase(it);
+}
+
+void GraphGraphicsScene::nodeIsolated(const std::string &name) {
+    removeIncidentEdgeItems(name);
+}
+
+void GraphGraphicsScene::nodeRenamed(const std::string &old_name, const std::string &new_name) {
+    nodeRemoved(old_name);
+    nodeAdded(new_name);
+}
+
+void GraphGraphicsScene::edgeAdded(const std::string &uname, const std::string &vname) {
+    edgeChanged(uname, vname);
+}
+
+void GraphGraphicsScene::edgeRemoved(const std::string &uname, const std::string &vname) {
+    edgeChanged(uname, vname);
+}
+
+void GraphGraphicsScene::weightChanged(const std::string &uname, const std::string &vname) {
+    edgeChanged(uname, vname);
+}
+
+void GraphGraphicsScene::syncEdgeItem(GraphType::Node *u, GraphType::Node *v) {
+    auto key = std::make_pair(u->name(), v->name());
+    bool exists = _graph->edgeSet().find({u, v}) != _graph->edgeSet().end();
+    auto it = _edgeItems.find(key);
+    bool shown = it != _edgeItems.end() || (_edgeLayer != nullptr && _edgeLayer->hasEdge(key));
+    if (exists && !shown)
+        createEdgeItem({u, v});
+    else if (!exists && shown)
+        removeEdgeItem(key);
+    else if (exists) {
+        // The layer refreshes its line and weight in place
+        if (_edgeLayer != nullptr)
+            createEdgeItem({u, v});
+        if (it != _edgeItems.end())
+            it->second->updatePosition();
+    }
+}
+
+void GraphGraphicsScene::edgeChanged(const std::string &uname, const std::string &vname) {
+    auto u = _graph->node(uname), v = _graph->node(vname);
+    if (u == nullptr || v == nullptr) {
+        removeEdgeItem(std::make_pair(uname, vname));
+        removeEdgeItem(std::make_pair(vname, uname));
+        return;
+    }
+    syncEdgeItem(u, v);
+    // An undirected edge is stored in whichever orientation it was first set,
+    // a directed one bends when its reverse edge appears or disappears
+    if (_graph->isUndirected())
+        syncEdgeItem(v, u);
+    else
+        updateReverseEdgeItem(uname, vname);
+}
+
+void GraphGraphicsScene::applyEvents(const std::vector<GraphType::GraphEvent> &events) {
+    // A batch touching most of the graph is cheaper to rebuild than to replay
+    if (events.size() > _nodeItems.size() + _edgeItems.size() + graph()->countNodes() + graph()->countEdges()) {
+        reload();
+        return;
+    }
+    for (const auto &event: events) {
+        if (_tiledRendering) {
+            if (event.type == GraphType::GraphEvent::Cleared)
+                _tiles->setGraph(graph());
+            else if (event.type == GraphType::GraphEvent::NodeAdded || event.type == GraphType::GraphEvent::NodeRemoved)
+                _tiles->invalidateNode(event.u);
+            else
+                _tiles->invalidateEdge(event.u, event.v);
+        }
+        switch (event.type) {
+            case GraphType::GraphEvent::NodeAdded:
+                nodeAdded(event.u);
+                break;
+            case GraphType::GraphEvent::NodeRemoved:
+                nodeRemoved(event.u);
+                break;
+            case GraphType::GraphEvent::EdgeSet:
+            case GraphType::GraphEvent::EdgeRemoved:
+                edgeChanged(event.u, event.v);
+                break;
+            case GraphType::GraphEvent::Cleared:
+                reload();
+                return;
         }
+    }
+}
+
+// Calls select(u, v) for what one step of a result shows, v is -1 for a node;
+// from is -1 where a step only reaches a node
+template<typename Select>
+static void selectDemoStep(GraphType::NodeId from, GraphType::NodeId to, GraphDemoFlag flag, Select select) {
+    bool nodes = flag == GraphDemoFlag::EdgeAndNode || flag == GraphDemoFlag::OnlyNode;
+    bool edges = flag == GraphDemoFlag::EdgeAndNode || flag == GraphDemoFlag::OnlyEdge;
+    if (nodes && from >= 0)
+        select(from, -1);
+    if (edges && from >= 0 && to >= 0)
+        select(from, to);
+    if (nodes && to >= 0)
+        select(to, -1);
+}
+
+static void addDemoStep(GraphType::PlaybackTimeline &timeline, GraphType::NodeId from, GraphType::NodeId to,
+                        GraphDemoFlag flag) {
+    selectDemoStep(from, to, flag, [&timeline](GraphType::NodeId u, GraphType::NodeId v) {
+        if (v < 0)
+            timeline.setNode(u, 0);
+        else
+            timeline.setEdge(u, v, 0);
     });
-    _uniqueTimer->start(_interval);
 }
 
-void GraphGraphicsScene::demoAlgorithm(const std::list<std::list<std::string> > &listOfListToDemo, GraphDemoFlag flag) {
-    resetAfterDemoAlgo();
-    this->_listOfList = listOfListToDemo;
-    _uniqueTimer = std::make_unique<QTimer>();
-
-    if (flag == GraphDemoFlag::Component) {
-        std::vector<QColor> colorTable;
-        for (int i = 0; i < this->_listOfList.size(); ++i) {
-            auto random = Random();
-            colorTable.emplace_back(QColor(random.drawNumber(0, 255), random.drawNumber(0, 255),
-                                           random.drawNumber(0, 255)));
+void GraphGraphicsScene::demoAlgorithm(const GraphType::NodePairSequence &pairs, GraphDemoFlag flag) {
+    GraphType::PlaybackTimeline timeline(pairs);
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        timeline.startStep();
+        addDemoStep(timeline, pairs.from(i), pairs.to(i), flag);
+    }
+    startDemo(std::move(timeline));
+}
+
+void GraphGraphicsScene::demoAlgorithm(const GraphType::NodeSequence &nodes, GraphDemoFlag flag) {
+    GraphType::PlaybackTimeline timeline(nodes);
+    // Consecutive nodes are joined by their edge, unless only nodes are shown
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        timeline.startStep();
+        if (flag == GraphDemoFlag::EdgeAndNode)
+            addDemoStep(timeline, nodes[i], i + 1 < nodes.size() ? nodes[i + 1] : -1, flag);
+        else if (flag == GraphDemoFlag::OnlyNode)
+            addDemoStep(timeline, nodes[i], -1, flag);
+    }
+    startDemo(std::move(timeline));
+}
+
+void GraphGraphicsScene::demoAlgorithm(const GraphType::NodeGroups &groups, GraphDemoFlag flag) {
+    GraphType::PlaybackTimeline timeline(groups);
+    const auto &graph = groups.graph();
+    if (flag == GraphDemoFlag::Component || flag == GraphDemoFlag::Coloring) {
+        // A colour per group, components get the edges inside them coloured too
+        std::vector<int> groupOf(graph.nodeCapacity(), -1);
+        for (size_t g = 0; g < groups.size(); ++g) {
+            for (size_t i = 0; i < groups.groupSize(g); ++i)
+                groupOf[groups.at(g, i)] = static_cast<int>(g);
         }
-        int org_size = this->_listOfList.size();
-        connect(_uniqueTimer.get(), &QTimer::timeout, this, [this, colorTable, org_size]() {
-            if (!this->_listOfList.empty()) {
-                QColor currColor = colorTable[org_size - this->_listOfList.size()];
-                std::list<std::string> currList = this->_listOfList.front();
-                this->_listOfList.pop_front();
-                for (const auto &start_name: currList) {
-                    for (const auto &end_name: currList) {
-                        if (start_name != end_name) {
-                            auto edgeItem = this->edgeItem(start_name, end_name);
-                            if (edgeItem != nullptr) {
-                                edgeItem->setOnSelectedColor(currColor);
-                                edgeItem->setSelected(true);
-                            }
-                        }
-                    }
-                    auto startItem = this->nodeItem(start_name);
-                    if (startItem != nullptr) {
-                        startItem->setOnSelectedColor(currColor);
-                        startItem->setSelected(true);
-                    }
-                }
-                this->update();
-            } else {
-                _uniqueTimer->stop();
-                this->_listOfList.clear();
+        std::vector<std::vector<int>> edgesOf(flag == GraphDemoFlag::Component ? groups.size() : 0);
+        for (int id = 0; id < graph.edgeCapacity() && !edgesOf.empty(); ++id) {
+            if (!graph.hasEdge(id))
+                continue;
+            int g = groupOf[graph.edge(id).u];
+            if (g >= 0 && g == groupOf[graph.edge(id).v])
+                edgesOf[g].push_back(id);
+        }
+        for (size_t g = 0; g < groups.size(); ++g) {
+            timeline.startStep();
+            int color = static_cast<int>(g) + 1;
+            for (size_t i = 0; i < groups.groupSize(g); ++i)
+                timeline.setNode(groups.at(g, i), color);
+            if (g < edgesOf.size()) {
+                for (int id: edgesOf[g])
+                    timeline.setEdge(graph.edge(id).u, graph.edge(id).v, color);
             }
-        });
-        _uniqueTimer->start(_interval);
+        }
     } else if (flag == GraphDemoFlag::EdgeAndNode) {
-        connect(_uniqueTimer.get(), &QTimer::timeout, this, [this]() {
-            if (!this->_listOfList.empty() || !this->_listOfNode.empty()) {
-                bool theLast;
-                if (this->_listOfNode.empty()) {
-                    this->_listOfNode = this->_listOfList.front();
-                    this->_listOfList.pop_front();
-                }
-                theLast = this->_listOfList.empty();
-
-                auto start_name = this->_listOfNode.front();
-                this->_listOfNode.pop_front();
-                auto end_name = !this->_listOfNode.empty() ? this->_listOfNode.front() : "";
-                auto startItem = this->nodeItem(start_name);
-                auto endItem = this->nodeItem(end_name);
-                auto edgeItem = this->edgeItem(start_name, end_name);
-                if (startItem != nullptr)
-                    startItem->setSelected(true);
-                if (endItem != nullptr)
-                    endItem->setSelected(true);
-                if (edgeItem != nullptr)
-                    edgeItem->setSelected(true);
-
-                this->update();
-                if (this->_listOfNode.empty() && !theLast) {
-                    for (auto gi: this->selectedItems())
-                        if (gi != nullptr)
-                            gi->setSelected(false);
-                }
-            } else {
-                _uniqueTimer->stop();
+        // Walks every group node by node, clearing the selection between groups
+        for (size_t g = 0; g < groups.size(); ++g) {
+            size_t count = groups.groupSize(g);
+            for (size_t i = 0; i < count; ++i) {
+                timeline.startStep();
+                if (i == 0)
+                    timeline.clear();
+                addDemoStep(timeline, groups.at(g, i), i + 1 < count ? groups.at(g, i + 1) : -1, flag);
             }
+        }
+    }
+    startDemo(std::move(timeline));
+}
+
+void GraphGraphicsScene::startDemo(GraphType::PlaybackTimeline timeline) {
+    resetAfterDemoAlgo();
+    this->_demo = std::move(timeline);
+    auto random = Random();
+    for (int i = 0; i < _demo.countColors(); ++i)
+        _demoColors.emplace_back(random.drawNumber(0, 255), random.drawNumber(0, 255), random.drawNumber(0, 255));
+    emit demoPositionChanged(0, static_cast<int>(_demo.size()));
+    playDemo();
+}
+
+void GraphGraphicsScene::demoStepwise(std::unique_ptr<GraphType::AlgorithmStepper> stepper, GraphDemoFlag flag) {
+    resetAfterDemoAlgo();
+    this->_stepper = std::move(stepper);
+    this->_stepperFlag = flag;
+    playDemo();
+}
+
+void GraphGraphicsScene::advanceStepper(long long steps) {
+    QElapsedTimer budget;
+    budget.start();
+    const auto &names = _stepper->names();
+    GraphType::AlgorithmStepper::Step step{};
+    // Steps the frame budget has no time for are dropped rather than piled up
+    for (long long i = 0; i < steps && budget.elapsed() < _frameBudget; ++i) {
+        if (!_stepper->next(step)) {
+            // What was shown stays selected
+            this->_stepper.reset();
+            pauseDemo();
+            break;
+        }
+        selectDemoStep(step.from, step.to, _stepperFlag, [this, &names](GraphType::NodeId u, GraphType::NodeId v) {
+            showDemoState(names, u, v, 0);
         });
-        _uniqueTimer->start(_interval);
     }
+    this->update();
+}
+
+void GraphGraphicsScene::playDemo() {
+    if (_stepper) {
+        this->_demoCarry = 0;
+        _demoClock.start();
+        _demoTimer.start();
+        return;
+    }
+    if (_demo.empty())
+        return;
+    // Playing on from either end starts over
+    if (!_demoReversed && _demo.position() == _demo.size())
+        seekDemo(0);
+    else if (_demoReversed && _demo.position() == 0)
+        seekDemo(static_cast<int>(_demo.size()));
+    this->_demoCarry = 0;
+    _demoClock.start();
+    _demoTimer.start();
+}
+
+void GraphGraphicsScene::pauseDemo() {
+    _demoTimer.stop();
+}
+
+void GraphGraphicsScene::stepDemo(int steps) {
+    pauseDemo();
+    if (_stepper) {
+        advanceStepper(steps);
+        return;
+    }
+    seekDemo(static_cast<int>(std::max<long long>(0, static_cast<long long>(_demo.position()) + steps)));
+}
+
+void GraphGraphicsScene::seekDemo(int step) {
+    if (_demo.empty())
+        return;
+    const auto &names = _demo.names();
+    auto show = [this, &names](GraphType::NodeId u, GraphType::NodeId v, int state) {
+        showDemoState(names, u, v, state);
+    };
+    _demo.seek(static_cast<size_t>(std::max(step, 0)), show);
+    this->update();
+    emit demoPositionChanged(static_cast<int>(_demo.position()), static_cast<int>(_demo.size()));
+}
+
+void GraphGraphicsScene::setDemoSpeed(double speed) {
+    this->_demoSpeed = std::max(speed, 0.01);
+}
+
+void GraphGraphicsScene::setDemoReversed(bool reversed) {
+    this->_demoReversed = reversed;
+}
+
+void GraphGraphicsScene::advanceDemo() {
+    // Steps per second; a long result plays faster, many steps a frame, to stay watchable
+    double size = _stepper ? _stepper->countNodes() : _demo.size();
+    double rate = std::max(1000. / _interval, size / _demoLongest) * _demoSpeed;
+    double steps = _demoCarry + rate * _demoClock.restart() / 1000.;
+    auto whole = static_cast<long long>(steps);
+    this->_demoCarry = steps - whole;
+    if (whole == 0)
+        return;
+    if (_stepper) {
+        advanceStepper(whole);
+        return;
+    }
+    auto position = static_cast<long long>(_demo.position());
+    auto target = _demoReversed ? std::max(0LL, position - whole)
+                                : std::min(static_cast<long long>(_demo.size()), position + whole);
+    seekDemo(static_cast<int>(target));
+    if (target == (_demoReversed ? 0 : static_cast<long long>(_demo.size())))
+        pauseDemo();
+}
+
+void GraphGraphicsScene::showDemoState(const GraphType::NodeNames &names, GraphType::NodeId u, GraphType::NodeId v,
+                                       int state) {
+    if (v < 0) {
+        const auto &name = names.name(u);
+        if (state >= 0)
+            _demoNodeStates[name] = state;
+        else
+            _demoNodeStates.erase(name);
+        applyDemoState(this->nodeItem(name), state);
+    } else {
+        auto key = std::make_pair(names.name(u), names.name(v));
+        if (_graph->isUndirected() && key.second < key.first)
+            std::swap(key.first, key.second);
+        if (state >= 0)
+            _demoEdgeStates[key] = state;
+        else
+            _demoEdgeStates.erase(key);
+        applyDemoState(this->edgeItem(key.first, key.second), state);
+    }
+}
+
+void GraphGraphicsScene::applyDemoState(NodeGraphicsItem *item, int state) {
+    if (item == nullptr)
+        return;
+    item->setOnSelectedColor(state > 0 ? _demoColors[state - 1] : NodeGraphicsItem::defaultOnSelectedColor());
+    item->setSelected(state >= 0);
+}
+
+void GraphGraphicsScene::applyDemoState(EdgeGraphicsItem *item, int state) {
+    if (item == nullptr)
+        return;
+    item->setOnSelectedColor(state > 0 ? _demoColors[state - 1] : EdgeGraphicsItem::defaultOnSelectedColor());
+    item->setSelected(state >= 0);
+}
+
+void GraphGraphicsScene::restoreDemoEdges() {
+    // Edges come back once both of their nodes have items again
+    for (const auto &it: _demoEdgeStates)
+        if (nodeItem(it.first.first) != nullptr && nodeItem(it.first.second) != nullptr)
+            applyDemoState(edgeItem(it.first.first, it.first.second), it.second);
 }
 
 void GraphGraphicsScene::resetAfterDemoAlgo() {
+    _demoTimer.stop();
     for (auto gi: selectedItems()) {
         if (gi) {
             auto ngi = dynamic_cast<NodeGraphicsItem *>(gi);
@@ -222,9 +792,15 @@ void GraphGraphicsScene::resetAfterDemoAlgo() {
             gi->setSelected(false);
         }
     }
-    this->_listOfList.clear();
-    this->_listOfNode.clear();
-    this->_listOfPair.clear();
+    if (!_demo.empty()) {
+        this->_demo = GraphType::PlaybackTimeline();
+        emit demoPositionChanged(0, 0);
+    }
+    _demoColors.clear();
+    _demoNodeStates.clear();
+    _demoEdgeStates.clear();
+    this->_stepper.reset();
+    demoteEdges();
 }
 
 EdgeGraphicsItem *GraphGraphicsScene::edgeItem(const std::string &uname, const std::string &vname) {
@@ -232,6 +808,8 @@ EdgeGraphicsItem *GraphGraphicsScene::edgeItem(const std::string &uname, const s
         return _edgeItems.find(std::make_pair(uname, vname))->second;
     else if (_graph->isUndirected() && _edgeItems.find(std::make_pair(vname, uname)) != _edgeItems.end())
         return _edgeItems.find(std::make_pair(vname, uname))->second;
+    else if (_edgeLayer != nullptr)
+        return promoteEdge(uname, vname);
     return nullptr;
 }
 
@@ -242,9 +820,21 @@ NodeGraphicsItem *GraphGraphicsScene::nodeItem(const std::string &name) {
 }
 
 void GraphGraphicsScene::clearAll() {
+    _animation.stop();
     this->clear();
     this->_nodeItems.clear();
     this->_edgeItems.clear();
+    this->_edgeLayer = nullptr;
+    this->_hits.clear();
+    for (auto item: _nodePool)
+        delete item;
+    this->_nodePool.clear();
+    this->_virtualNodes.clear();
+    this->_positions.clear();
+    this->_virtualIds.clear();
+    this->_nodeIndex.clear();
+    this->_nodeBounds = QRectF();
+    this->_nodesCollapsed = false;
 }
 
 GraphGraphicsScene::~GraphGraphicsScene() {
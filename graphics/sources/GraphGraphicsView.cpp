@@ -20,15 +20,31 @@ void GraphGraphicsView::wheelEvent(QWheelEvent *event) {
         scale(1 / scaleFactor, 1 / scaleFactor);
         _currentScale /= scaleFactor;
     }
+    updateVisibleRect();
+}
+
+void GraphGraphicsView::scrollContentsBy(int dx, int dy) {
+    QGraphicsView::scrollContentsBy(dx, dy);
+    updateVisibleRect();
+}
+
+void GraphGraphicsView::resizeEvent(QResizeEvent *event) {
+    QGraphicsView::resizeEvent(event);
+    updateVisibleRect();
+}
+
+void GraphGraphicsView::updateVisibleRect() {
+    auto graphScene = dynamic_cast<GraphGraphicsScene *>(scene());
+    if (graphScene != nullptr)
+        graphScene->setVisibleRect(mapToScene(viewport()->rect()).boundingRect());
 }
 
 void GraphGraphicsView::contextMenuEvent(QContextMenuEvent *event) {
     for (auto gi: scene()->selectedItems())
         gi->setSelected(false);
 
-    QList<QGraphicsItem *> clickedItems = items(event->pos());
-    if (!clickedItems.empty()) {
-        auto item = clickedItems[0];
+    QGraphicsItem *item = dynamic_cast<GraphGraphicsScene *>(scene())->hitItem(mapToScene(event->pos()));
+    if (item != nullptr) {
         item->setSelected(true);
 
         auto *edgeItem = dynamic_cast<EdgeGraphicsItem *>(item);
@@ -94,21 +110,26 @@ void GraphGraphicsView::mousePressEvent(QMouseEvent *event) {
     }
 
     auto graphScene = dynamic_cast<GraphGraphicsScene *>(scene());
-    if (graphScene->_uniqueTimer) {
-        graphScene->_uniqueTimer->stop();
-    }
     graphScene->resetAfterDemoAlgo();
+    // Makes sure a batched edge or a virtualized node under the cursor has an item to select
+    auto hit = graphScene->hitItem(mapToScene(event->pos()));
 
+    if (hit == nullptr && !_selectTargetNode && event->button() == Qt::LeftButton
+        && event->modifiers() & Qt::ShiftModifier) {
+        if (_rubberBand == nullptr)
+            this->_rubberBand = new QRubberBand(QRubberBand::Rectangle, viewport());
+        this->_rubberOrigin = event->pos();
+        _rubberBand->setGeometry(QRect(_rubberOrigin, QSize()));
+        _rubberBand->show();
+        return;
+    }
     if (!_selectTargetNode)
         QGraphicsView::mousePressEvent(event);
     if (_selectTargetNode) {
-        QList<QGraphicsItem *> itemsTo = items(event->pos());
-        if (!itemsTo.empty()) {
-            auto *castedItemTo = dynamic_cast<NodeGraphicsItem *>(itemsTo[0]);
-            if (_startItem && castedItemTo && _startItem != castedItemTo) {
-                castedItemTo->setSelected(false);
-                emit edgeSet(_startItem->node()->name(), castedItemTo->node()->name());
-            }
+        auto *castedItemTo = dynamic_cast<NodeGraphicsItem *>(hit);
+        if (_startItem && castedItemTo && _startItem != castedItemTo) {
+            castedItemTo->setSelected(false);
+            emit edgeSet(_startItem->node()->name(), castedItemTo->node()->name());
         }
     }
     _selectTargetNode = false;
@@ -117,22 +138,47 @@ void GraphGraphicsView::mousePressEvent(QMouseEvent *event) {
     viewport()->update();
 }
 
+void GraphGraphicsView::mouseMoveEvent(QMouseEvent *event) {
+    if (_rubberBand != nullptr && _rubberBand->isVisible()) {
+        _rubberBand->setGeometry(QRect(_rubberOrigin, event->pos()).normalized());
+        return;
+    }
+    QGraphicsView::mouseMoveEvent(event);
+    // Items ignore hover events, the cursor follows the index instead
+    auto graphScene = dynamic_cast<GraphGraphicsScene *>(scene());
+    if (graphScene == nullptr)
+        return;
+    if (scene()->mouseGrabberItem() != nullptr)
+        viewport()->setCursor(Qt::ClosedHandCursor);
+    else if (event->buttons() == Qt::NoButton)
+        viewport()->setCursor(graphScene->isHit(mapToScene(event->pos())) ? Qt::PointingHandCursor
+                                                                           : Qt::OpenHandCursor);
+}
+
 void GraphGraphicsView::mouseReleaseEvent(QMouseEvent *event) {
+    auto graphScene = dynamic_cast<GraphGraphicsScene *>(scene());
+    if (_rubberBand != nullptr && _rubberBand->isVisible()) {
+        _rubberBand->hide();
+        for (auto item: graphScene->hitItems(mapToScene(_rubberBand->geometry()).boundingRect()))
+            item->setSelected(true);
+        scene()->update();
+        return;
+    }
     if (!scene()->selectedItems().empty()) {
         auto fni = dynamic_cast<NodeGraphicsItem *>(scene()->selectedItems()[0]);
         auto fai = dynamic_cast<EdgeGraphicsItem *>(scene()->selectedItems()[0]);
         if (fai) emit edgeSelected(fai->edge().u()->name(), fai->edge().v()->name());
         else if (fni) emit nodeSelected(fni->node()->name());
     }
-    if (items(event->pos()).empty())
+    if (!graphScene->isHit(mapToScene(event->pos())))
             emit unSelected();
     QGraphicsView::mouseReleaseEvent(event);
 }
 
 void GraphGraphicsView::setScene(GraphGraphicsScene *scene) {
-    connect(scene, SIGNAL(graphChanged()), this, SLOT(redraw()));
     connect(scene, SIGNAL(needRedraw()), this, SLOT(redraw()));
     QGraphicsView::setScene(scene);
+    updateVisibleRect();
 }
 
 void GraphGraphicsView::redraw() {
@@ -0,0 +1,190 @@
+#include "graphics/headers/HitIndex.h"
+#include <algorithm>
+
+QRectF HitIndex::circleRect(const QPointF &center, qreal radius) {
+    return {center.x() - radius, center.y() - radius, radius * 2, radius * 2};
+}
+
+void HitIndex::setNode(const std::string &name, const QPointF &center, qreal radius) {
+    auto it = _nodeIds.find(name);
+    int id;
+    if (it != _nodeIds.end()) {
+        id = it->second;
+    } else if (!_freeNodes.empty()) {
+        id = _freeNodes.back();
+        _freeNodes.pop_back();
+    } else {
+        id = static_cast<int>(_nodes.size());
+        _nodes.emplace_back();
+    }
+    this->_nodes[id] = {center, radius, name};
+    this->_nodeIds[name] = id;
+    this->_nodeTree.insert(id, circleRect(center, radius));
+}
+
+void HitIndex::moveNode(const std::string &name, const QPointF &center) {
+    auto it = _nodeIds.find(name);
+    if (it == _nodeIds.end())
+        return;
+    auto &node = _nodes[it->second];
+    node.center = center;
+    _nodeTree.update(it->second, circleRect(center, node.radius));
+    auto incident = _incident.find(name);
+    if (incident == _incident.end())
+        return;
+    for (int id: incident->second) {
+        auto &edge = _edges[id];
+        if (edge.key.first == name)
+            edge.line.setP1(center);
+        if (edge.key.second == name)
+            edge.line.setP2(center);
+        _edgeTree.update(id, QRectF(edge.line.p1(), edge.line.p2()).normalized());
+    }
+}
+
+void HitIndex::removeNode(const std::string &name) {
+    removeIncidentEdges(name);
+    auto it = _nodeIds.find(name);
+    if (it == _nodeIds.end())
+        return;
+    _nodeTree.remove(it->second);
+    _freeNodes.push_back(it->second);
+    _nodeIds.erase(it);
+}
+
+void HitIndex::setEdge(const Key &key, const QPointF &p1, const QPointF &p2) {
+    auto it = _edgeIds.find(key);
+    int id;
+    if (it != _edgeIds.end()) {
+        id = it->second;
+    } else {
+        if (!_freeEdges.empty()) {
+            id = _freeEdges.back();
+            _freeEdges.pop_back();
+        } else {
+            id = static_cast<int>(_edges.size());
+            _edges.emplace_back();
+        }
+        _edgeIds[key] = id;
+        _incident[key.first].push_back(id);
+        if (key.second != key.first)
+            _incident[key.second].push_back(id);
+    }
+    this->_edges[id] = {QLineF(p1, p2), key};
+    this->_edgeTree.insert(id, QRectF(p1, p2).normalized());
+}
+
+void HitIndex::removeEdge(const Key &key) {
+    auto it = _edgeIds.find(key);
+    if (it == _edgeIds.end())
+        return;
+    int id = it->second;
+    _edgeIds.erase(it);
+    for (const auto &name: {key.first, key.second}) {
+        auto incident = _incident.find(name);
+        if (incident == _incident.end())
+            continue;
+        auto &ids = incident->second;
+        ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+        if (ids.empty())
+            _incident.erase(incident);
+    }
+    _edgeTree.remove(id);
+    _freeEdges.push_back(id);
+}
+
+void HitIndex::removeIncidentEdges(const std::string &name) {
+    auto it = _incident.find(name);
+    if (it == _incident.end())
+        return;
+    auto ids = it->second;
+    for (int id: ids) {
+        auto key = _edges[id].key;
+        removeEdge(key);
+    }
+}
+
+void HitIndex::clear() {
+    this->_nodes.clear();
+    this->_freeNodes.clear();
+    this->_nodeIds.clear();
+    this->_nodeTree.clear();
+    this->_edges.clear();
+    this->_freeEdges.clear();
+    this->_edgeIds.clear();
+    this->_incident.clear();
+    this->_edgeTree.clear();
+}
+
+bool HitIndex::nodeAt(const QPointF &point, std::string &name) const {
+    qreal best = -1;
+    for (int id: _nodeTree.query(QRectF(point, point))) {
+        const auto &node = _nodes[id];
+        qreal d = QLineF(point, node.center).length();
+        if (d <= node.radius && (best < 0 || d < best)) {
+            best = d;
+            name = node.name;
+        }
+    }
+    return best >= 0;
+}
+
+qreal HitIndex::distance(const QPointF &point, const QLineF &line) {
+    QPointF d = line.p2() - line.p1();
+    qreal length = d.x() * d.x() + d.y() * d.y();
+    qreal t = length > 0 ? QPointF::dotProduct(point - line.p1(), d) / length : 0;
+    t = std::max<qreal>(0, std::min<qreal>(1, t));
+    return QLineF(point, line.p1() + d * t).length();
+}
+
+bool HitIndex::edgeAt(const QPointF &point, Key &key, qreal tolerance) const {
+    QRectF area(point.x() - tolerance, point.y() - tolerance, tolerance * 2, tolerance * 2);
+    qreal best = tolerance;
+    int found = -1;
+    for (int id: _edgeTree.query(area)) {
+        qreal d = distance(point, _edges[id].line);
+        if (d <= best) {
+            best = d;
+            found = id;
+        }
+    }
+    if (found < 0)
+        return false;
+    key = _edges[found].key;
+    return true;
+}
+
+void HitIndex::nodesIn(const QRectF &rect, std::vector<std::string> &names) const {
+    for (int id: _nodeTree.query(rect))
+        if (rect.contains(_nodes[id].center))
+            names.push_back(_nodes[id].name);
+}
+
+bool HitIndex::crosses(const QLineF &line, const QRectF &rect) {
+    // Liang-Barsky clipping of the segment against the rectangle
+    qreal t0 = 0, t1 = 1;
+    qreal dx = line.dx(), dy = line.dy();
+    qreal p[4] = {-dx, dx, -dy, dy};
+    qreal q[4] = {line.x1() - rect.left(), rect.right() - line.x1(), line.y1() - rect.top(), rect.bottom() - line.y1()};
+    for (int i = 0; i < 4; ++i) {
+        if (p[i] == 0) {
+            if (q[i] < 0)
+                return false;
+            continue;
+        }
+        qreal t = q[i] / p[i];
+        if (p[i] < 0)
+            t0 = std::max(t0, t);
+        else
+            t1 = std::min(t1, t);
+        if (t0 > t1)
+            return false;
+    }
+    return true;
+}
+
+void HitIndex::edgesIn(const QRectF &rect, std::vector<Key> &keys) const {
+    for (int id: _edgeTree.query(rect))
+        if (crosses(_edges[id].line, rect))
+            keys.push_back(_edges[id].key);
+}
@@ -1,5 +1,6 @@
 #include "graphics/headers/NodeGraphicsItem.h"
 #include "graphics/headers/GraphGraphicsScene.h"
+#include "graphics/headers/QtPoint.h"
 #include <QtWidgets>
 #include <QDebug>
 #include <utility>
@@ -10,17 +11,40 @@ NodeGraphicsItem::NodeGraphicsItem(GraphGraphicsScene *scene, GraphType::Node *n
     this->_color = std::move(color);
     this->_radius = 80;
     setFlag(QGraphicsItem::ItemIsSelectable, true);
-    setAcceptHoverEvents(true);
+    setZValue(1);
     setNode(node);
     _isMoving = false;
     _selectedColor = defaultOnSelectedColor();
 }
 
 void NodeGraphicsItem::setNode(GraphType::Node *node) {
+    prepareGeometryChange();
     this->_node = node;
-    this->setPos(_node->euclidePos());
-    QFontMetrics fm(QFont(_font, _fontSize));
-    _radius = std::max(_radius, fm.width(QString::fromStdString(_node->name() + "  ")));
+    this->setPos(toQPointF(_node->euclidePos()));
+    QFontMetrics fm(labelFont());
+    _radius = diameterFor(_node->name());
+
+    QString txt = QString::fromStdString(_node->name());
+    this->_label.setText(txt);
+    this->_label.setTextFormat(Qt::PlainText);
+    this->_label.prepare(QTransform(), labelFont());
+    this->_labelPos = QPointF(-fm.width(txt) / 2., fm.height() / 3. - fm.ascent());
+}
+
+void NodeGraphicsItem::moveTo(const QPointF &pos) {
+    setPos(pos);
+    _gscene->graph()->setNodePos(this->node(), toPoint(pos));
+    emit positionChanged();
+}
+
+const QFont &NodeGraphicsItem::labelFont() {
+    static const QFont font("Source Code Pro", 10);
+    return font;
+}
+
+int NodeGraphicsItem::diameterFor(const std::string &name) {
+    QFontMetrics fm(labelFont());
+    return std::max(80, fm.width(QString::fromStdString(name + "  ")));
 }
 
 GraphType::Node *NodeGraphicsItem::node() const {
@@ -35,6 +59,10 @@ QRectF NodeGraphicsItem::boundingRect() const {
     };
 }
 
+bool NodeGraphicsItem::contains(const QPointF &point) const {
+    return point.x() * point.x() + point.y() * point.y() <= _radius * _radius / 4.;
+}
+
 const QList<QColor> &NodeGraphicsItem::colorTable() {
     static QList<QColor> colorTable = {
             QColor(244, 164, 96),
@@ -62,21 +90,28 @@ QColor NodeGraphicsItem::defaultColor() { return colorTable()[0]; }
 QColor NodeGraphicsItem::defaultOnSelectedColor() { return colorTable()[1]; }
 
 void NodeGraphicsItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) {
-    Q_UNUSED(option);
     Q_UNUSED(widget);
+    if (_gscene->tilesActive() && !isSelected() && !_isMoving)
+        return;
     if (isSelected())
         _color = onSelectedColor();
     else
         _color = defaultColor();
+    qreal detail = option->levelOfDetailFromTransform(painter->worldTransform());
+    if (detail < _shapeDetail) {
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(_color);
+        painter->drawRect(-_radius / 2, -_radius / 2, _radius, _radius);
+        return;
+    }
     painter->setPen(QPen(Qt::black, 2, Qt::SolidLine));
     painter->setBrush(QBrush(_color));
     painter->drawEllipse(-_radius / 2, -_radius / 2, _radius, _radius);
 
-    QFont font(_font, _fontSize);
-    painter->setFont(font);
-    QString txt = QString::fromStdString(this->node()->name());
-    QFontMetrics fm(font);
-    painter->drawText(-fm.width(txt) / 2, fm.height() / 3, txt);
+    if (detail < _labelDetail)
+        return;
+    painter->setFont(labelFont());
+    painter->drawStaticText(_labelPos, _label);
 }
 
 void NodeGraphicsItem::mouseMoveEvent(QGraphicsSceneMouseEvent *event) {
@@ -85,11 +120,8 @@ void NodeGraphicsItem::mouseMoveEvent(QGraphicsSceneMouseEvent *event) {
         return;
     }
     _isMoving = true;
-    setCursor(Qt::ClosedHandCursor);
-    setPos(event->scenePos());
-    this->node()->setEuclidePos(this->pos());
-    emit _gscene->needRedraw();
-    emit positionChanged();
+    moveTo(event->scenePos());
+    _gscene->requestRedraw();
     QGraphicsItem::mouseMoveEvent(event);
 }
 
@@ -100,12 +132,6 @@ void NodeGraphicsItem::mouseReleaseEvent(QGraphicsSceneMouseEvent *event) {
         _isMoving = false;
     }
     //emit this->_gscene->graphChanged();
-    setCursor(Qt::OpenHandCursor);
-}
-
-void NodeGraphicsItem::hoverEnterEvent(QGraphicsSceneHoverEvent *event) {
-    QGraphicsItem::hoverEnterEvent(event);
-    setCursor(Qt::PointingHandCursor);
 }
 
 QColor NodeGraphicsItem::onSelectedColor() const {
@@ -0,0 +1,150 @@
+#include "graphics/headers/QuadTree.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // QRectF::intersects/contains reject the zero-height rectangles of axis-aligned edges
+    bool overlaps(const QRectF &a, const QRectF &b) {
+        return a.left() <= b.right() && b.left() <= a.right() && a.top() <= b.bottom() && b.top() <= a.bottom();
+    }
+
+    bool encloses(const QRectF &outer, const QRectF &inner) {
+        return outer.left() <= inner.left() && inner.right() <= outer.right()
+               && outer.top() <= inner.top() && inner.bottom() <= outer.bottom();
+    }
+}
+
+QuadTree::QuadTree(const QRectF &bounds, int capacity, int maxDepth) :
+        _root(new Cell(bounds)),
+        _initialBounds(bounds),
+        _capacity(capacity),
+        _maxDepth(maxDepth) {}
+
+int QuadTree::childIndex(const Cell *cell, const QRectF &rect) {
+    auto center = cell->bounds.center();
+    bool left = rect.right() <= center.x(), right = rect.left() >= center.x();
+    bool top = rect.bottom() <= center.y(), bottom = rect.top() >= center.y();
+    if (top && left) return 0;
+    if (top && right) return 1;
+    if (bottom && left) return 2;
+    if (bottom && right) return 3;
+    return -1;
+}
+
+void QuadTree::insert(int id, const QRectF &rect) {
+    if (contains(id))
+        remove(id);
+    grow(rect);
+    _rects[id] = rect;
+    insert(_root.get(), 0, {id, rect});
+}
+
+void QuadTree::insert(Cell *cell, int depth, const Entry &entry) {
+    while (!cell->isLeaf()) {
+        int index = childIndex(cell, entry.rect);
+        if (index < 0) break;
+        cell = cell->children[index].get();
+        ++depth;
+    }
+    cell->entries.push_back(entry);
+    if (cell->isLeaf() && static_cast<int>(cell->entries.size()) > _capacity && depth < _maxDepth)
+        split(cell, depth);
+}
+
+void QuadTree::split(Cell *cell, int depth) {
+    auto b = cell->bounds;
+    qreal w = b.width() / 2, h = b.height() / 2;
+    cell->children[0].reset(new Cell(QRectF(b.left(), b.top(), w, h)));
+    cell->children[1].reset(new Cell(QRectF(b.left() + w, b.top(), w, h)));
+    cell->children[2].reset(new Cell(QRectF(b.left(), b.top() + h, w, h)));
+    cell->children[3].reset(new Cell(QRectF(b.left() + w, b.top() + h, w, h)));
+    std::vector<Entry> entries;
+    entries.swap(cell->entries);
+    for (const auto &entry: entries) {
+        int index = childIndex(cell, entry.rect);
+        if (index < 0)
+            cell->entries.push_back(entry);
+        else
+            insert(cell->children[index].get(), depth + 1, entry);
+    }
+}
+
+void QuadTree::grow(const QRectF &rect) {
+    if (!std::isfinite(rect.left() + rect.right() + rect.top() + rect.bottom()))
+        return;
+    while (!encloses(_root->bounds, rect)) {
+        // Double the root towards the new rectangle, the old root becomes one of the quadrants
+        auto b = _root->bounds;
+        bool growLeft = rect.left() < b.left(), growUp = rect.top() < b.top();
+        QRectF bounds(growLeft ? b.left() - b.width() : b.left(),
+                      growUp ? b.top() - b.height() : b.top(),
+                      b.width() * 2, b.height() * 2);
+        std::unique_ptr<Cell> root(new Cell(bounds));
+        int oldIndex = (growUp ? 2 : 0) + (growLeft ? 1 : 0);
+        qreal w = b.width(), h = b.height();
+        for (int i = 0; i < 4; ++i) {
+            if (i == oldIndex) continue;
+            root->children[i].reset(new Cell(QRectF(bounds.left() + (i % 2) * w, bounds.top() + (i / 2) * h, w, h)));
+        }
+        root->children[oldIndex] = std::move(_root);
+        _root = std::move(root);
+    }
+}
+
+bool QuadTree::remove(int id) {
+    auto it = _rects.find(id);
+    if (it == _rects.end())
+        return false;
+    remove(_root.get(), id, it->second);
+    _rects.erase(it);
+    return true;
+}
+
+bool QuadTree::remove(Cell *cell, int id, const QRectF &rect) {
+    while (cell != nullptr) {
+        auto it = std::find_if(cell->entries.begin(), cell->entries.end(),
+                               [id](const Entry &entry) { return entry.id == id; });
+        if (it != cell->entries.end()) {
+            *it = cell->entries.back();
+            cell->entries.pop_back();
+            return true;
+        }
+        if (cell->isLeaf())
+            return false;
+        int index = childIndex(cell, rect);
+        cell = index < 0 ? nullptr : cell->children[index].get();
+    }
+    return false;
+}
+
+void QuadTree::update(int id, const QRectF &rect) {
+    remove(id);
+    insert(id, rect);
+}
+
+void QuadTree::clear() {
+    this->_root.reset(new Cell(_initialBounds));
+    this->_rects.clear();
+}
+
+void QuadTree::query(const QRectF &area, std::vector<int> &result) const {
+    query(_root.get(), area, result);
+}
+
+std::vector<int> QuadTree::query(const QRectF &area) const {
+    std::vector<int> result;
+    query(_root.get(), area, result);
+    return result;
+}
+
+void QuadTree::query(const Cell *cell, const QRectF &area, std::vector<int> &result) {
+    if (!overlaps(cell->bounds, area))
+        return;
+    for (const auto &entry: cell->entries)
+        if (overlaps(entry.rect, area))
+            result.push_back(entry.id);
+    if (cell->isLeaf())
+        return;
+    for (const auto &child: cell->children)
+        query(child.get(), area, result);
+}
@@ -0,0 +1,310 @@
+#include "graphics/headers/TileCache.h"
+#include "graphics/headers/EdgeLayerItem.h"
+#include "graphics/headers/EdgeGraphicsItem.h"
+#include "graphics/headers/NodeGraphicsItem.h"
+#include "graphics/headers/QtPoint.h"
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QtConcurrent>
+#include <algorithm>
+#include <cmath>
+
+TileCache::TileCache(QObject *parent) :
+        QObject(parent),
+        _ready(false),
+        _generation(0),
+        _frame(0) {
+    _rebuildTimer.setSingleShot(true);
+    _rebuildTimer.setInterval(250);
+    connect(&_rebuildTimer, &QTimer::timeout, this, &TileCache::rebuild);
+    connect(&_snapshotWatcher, &QFutureWatcherBase::finished, this, [this]() {
+        // Another change arrived while building, a newer snapshot follows
+        if (_rebuildTimer.isActive())
+            return;
+        this->_snapshot = _snapshotWatcher.result();
+        this->_ready = true;
+        emit readyChanged();
+    });
+}
+
+void TileCache::setGraph(GraphType::Graph *graph) {
+    this->_graph = graph;
+    this->_snapshot.reset();
+    this->_tiles.clear();
+    this->_pending.clear();
+    ++_generation;
+    markStale();
+}
+
+void TileCache::markStale() {
+    if (_ready) {
+        this->_ready = false;
+        emit readyChanged();
+    }
+    _rebuildTimer.start();
+}
+
+qreal TileCache::levelScale(int level) {
+    return std::pow(2., level / 2.);
+}
+
+QRectF TileCache::tileRect(const TileKey &key) {
+    qreal size = _tileSize / levelScale(key.level);
+    return {key.x * size, key.y * size, size, size};
+}
+
+void TileCache::rebuild() {
+    if (_graph == nullptr)
+        return;
+    if (_snapshotWatcher.isRunning()) {
+        _rebuildTimer.start();
+        return;
+    }
+    // Only plain copies are taken here, indexing and measuring happen on a worker
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->directed = _graph->isDirected();
+    snapshot->weighted = _graph->isWeighted();
+    snapshot->nodeColor = NodeGraphicsItem::defaultColor();
+    snapshot->edgeColor = EdgeGraphicsItem::defaultColor();
+    std::unordered_map<const GraphType::Node *, int> index;
+    index.reserve(_graph->countNodes());
+    snapshot->positions.reserve(_graph->countNodes());
+    snapshot->names.reserve(_graph->countNodes());
+    for (const auto &node: _graph->nodeList()) {
+        index[node] = static_cast<int>(snapshot->positions.size());
+        snapshot->positions.push_back(toQPointF(node->euclidePos()));
+        snapshot->names.push_back(node->name());
+    }
+    snapshot->lines.reserve(_graph->countEdges());
+    snapshot->weights.reserve(_graph->countEdges());
+    snapshot->ends.reserve(_graph->countEdges());
+    for (const auto &it: _graph->edgeSet()) {
+        snapshot->lines.emplace_back(toQPointF(it.first.first->euclidePos()),
+                                     toQPointF(it.first.second->euclidePos()));
+        snapshot->weights.push_back(it.second);
+        snapshot->ends.emplace_back(index[it.first.first], index[it.first.second]);
+    }
+    _snapshotWatcher.setFuture(QtConcurrent::run(&TileCache::buildSnapshot, snapshot));
+}
+
+std::shared_ptr<const TileCache::Snapshot> TileCache::buildSnapshot(std::shared_ptr<Snapshot> snapshot) {
+    int n = static_cast<int>(snapshot->positions.size());
+    snapshot->radii.resize(n);
+    snapshot->ids.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        snapshot->radii[i] = NodeGraphicsItem::diameterFor(snapshot->names[i]);
+        snapshot->maxRadius = std::max(snapshot->maxRadius, snapshot->radii[i]);
+        snapshot->ids[snapshot->names[i]] = i;
+        snapshot->nodeIndex.insert(i, QRectF(snapshot->positions[i], snapshot->positions[i]));
+    }
+    int m = static_cast<int>(snapshot->lines.size());
+    snapshot->incidentStart.assign(n + 1, 0);
+    for (int e = 0; e < m; ++e) {
+        snapshot->edgeIndex.insert(e, QRectF(snapshot->lines[e].p1(), snapshot->lines[e].p2()).normalized());
+        ++snapshot->incidentStart[snapshot->ends[e].first + 1];
+        ++snapshot->incidentStart[snapshot->ends[e].second + 1];
+    }
+    for (int i = 0; i < n; ++i)
+        snapshot->incidentStart[i + 1] += snapshot->incidentStart[i];
+    snapshot->incident.resize(m * 2);
+    std::vector<int> fill(snapshot->incidentStart.begin(), snapshot->incidentStart.end() - 1);
+    for (int e = 0; e < m; ++e) {
+        snapshot->incident[fill[snapshot->ends[e].first]++] = e;
+        snapshot->incident[fill[snapshot->ends[e].second]++] = e;
+    }
+    return snapshot;
+}
+
+void TileCache::invalidate(const QRectF &rect) {
+    for (auto it = _tiles.begin(); it != _tiles.end();) {
+        if (tileRect(it->first).intersects(rect))
+            it = _tiles.erase(it);
+        else
+            ++it;
+    }
+    // Tiles in flight may have been drawn from the old geometry
+    ++_generation;
+    this->_pending.clear();
+    markStale();
+}
+
+void TileCache::invalidateNode(const std::string &name) {
+    qreal margin = 40;
+    auto node = _graph != nullptr ? _graph->node(name) : nullptr;
+    if (node != nullptr) {
+        qreal r = std::max(80, _snapshot ? _snapshot->maxRadius : 0) / 2. + margin;
+        invalidate(QRectF(toQPointF(node->euclidePos()) - QPointF(r, r), QSizeF(r * 2, r * 2)));
+    }
+    if (!_snapshot) {
+        markStale();
+        return;
+    }
+    auto it = _snapshot->ids.find(name);
+    if (it == _snapshot->ids.end())
+        return;
+    int id = it->second;
+    qreal r = _snapshot->radii[id] / 2. + margin;
+    invalidate(QRectF(_snapshot->positions[id] - QPointF(r, r), QSizeF(r * 2, r * 2)));
+    for (int i = _snapshot->incidentStart[id]; i < _snapshot->incidentStart[id + 1]; ++i) {
+        int e = _snapshot->incident[i];
+        const auto &line = _snapshot->lines[e];
+        invalidate(QRectF(line.p1(), line.p2()).normalized().adjusted(-margin, -margin, margin, margin));
+        if (node != nullptr) {
+            int other = _snapshot->ends[e].first == id ? _snapshot->ends[e].second : _snapshot->ends[e].first;
+            QRectF moved(toQPointF(node->euclidePos()), _snapshot->positions[other]);
+            invalidate(moved.normalized().adjusted(-margin, -margin, margin, margin));
+        }
+    }
+}
+
+void TileCache::invalidateEdge(const std::string &uname, const std::string &vname) {
+    qreal margin = 40;
+    if (_graph != nullptr) {
+        auto u = _graph->node(uname), v = _graph->node(vname);
+        if (u != nullptr && v != nullptr)
+            invalidate(QRectF(toQPointF(u->euclidePos()), toQPointF(v->euclidePos())).normalized()
+                               .adjusted(-margin, -margin, margin, margin));
+    }
+    if (!_snapshot) {
+        markStale();
+        return;
+    }
+    auto u = _snapshot->ids.find(uname), v = _snapshot->ids.find(vname);
+    if (u != _snapshot->ids.end() && v != _snapshot->ids.end())
+        invalidate(QRectF(_snapshot->positions[u->second], _snapshot->positions[v->second]).normalized()
+                           .adjusted(-margin, -margin, margin, margin));
+}
+
+void TileCache::paint(QPainter *painter, const QRectF &rect) {
+    if (!_ready || !_snapshot)
+        return;
+    qreal scale = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    if (scale <= 0)
+        return;
+    // Tiles are rendered at the next finer level and only ever scaled down
+    int level = static_cast<int>(std::ceil(std::log2(scale) * 2));
+    qreal size = _tileSize / levelScale(level);
+    int x0 = static_cast<int>(std::floor(rect.left() / size)), x1 = static_cast<int>(std::floor(rect.right() / size));
+    int y0 = static_cast<int>(std::floor(rect.top() / size)), y1 = static_cast<int>(std::floor(rect.bottom() / size));
+    ++_frame;
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            TileKey key{level, x, y};
+            auto it = _tiles.find(key);
+            if (it != _tiles.end()) {
+                it->second.lastUsed = _frame;
+                painter->drawImage(tileRect(key), it->second.image);
+                continue;
+            }
+            // Until the worker delivers, this part is drawn directly from the snapshot
+            requestTile(key);
+            QRectF area = tileRect(key).intersected(rect);
+            painter->save();
+            painter->setClipRect(area);
+            draw(painter, *_snapshot, area, scale);
+            painter->restore();
+        }
+    }
+}
+
+void TileCache::requestTile(const TileKey &key) {
+    if (_pending.find(key) != _pending.end())
+        return;
+    unsigned long generation = _generation;
+    _pending[key] = generation;
+    auto watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, key, generation]() {
+        watcher->deleteLater();
+        auto it = _pending.find(key);
+        if (it == _pending.end() || it->second != generation || generation != _generation)
+            return;
+        _pending.erase(it);
+        _tiles[key] = {watcher->result(), _frame};
+        evict();
+    });
+    watcher->setFuture(QtConcurrent::run(&TileCache::renderTile, _snapshot, tileRect(key), levelScale(key.level)));
+}
+
+void TileCache::evict() {
+    if (static_cast<int>(_tiles.size()) <= _maxTiles)
+        return;
+    std::vector<std::pair<unsigned long, TileKey>> order;
+    order.reserve(_tiles.size());
+    for (const auto &it: _tiles)
+        order.emplace_back(it.second.lastUsed, it.first);
+    std::sort(order.begin(), order.end(), [](const std::pair<unsigned long, TileKey> &a,
+                                             const std::pair<unsigned long, TileKey> &b) {
+        return a.first < b.first;
+    });
+    int count = static_cast<int>(_tiles.size()) - _maxTiles * 3 / 4;
+    for (int i = 0; i < count; ++i)
+        _tiles.erase(order[i].second);
+}
+
+QImage TileCache::renderTile(std::shared_ptr<const Snapshot> snapshot, QRectF area, qreal scale) {
+    QImage image(_tileSize, _tileSize, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter painter(&image);
+    painter.scale(scale, scale);
+    painter.translate(-area.topLeft());
+    draw(&painter, *snapshot, area, scale);
+    return image;
+}
+
+void TileCache::draw(QPainter *painter, const Snapshot &snapshot, const QRectF &area, qreal scale) {
+    // Same detail thresholds as EdgeLayerItem and NodeGraphicsItem
+    qreal margin = snapshot.maxRadius / 2. + 40;
+    QRectF query = area.adjusted(-margin, -margin, margin, margin);
+    std::vector<int> ids;
+    snapshot.edgeIndex.query(query, ids);
+    std::vector<QLineF> bodies, heads;
+    bodies.reserve(ids.size());
+    bool arrows = snapshot.directed && scale >= 0.35;
+    for (int e: ids) {
+        bodies.push_back(snapshot.lines[e]);
+        if (arrows)
+            EdgeLayerItem::appendArrowHead(snapshot.lines[e], heads);
+    }
+    painter->setPen(QPen(snapshot.edgeColor, scale < 0.35 ? 0 : 2));
+    painter->drawLines(bodies.data(), static_cast<int>(bodies.size()));
+    if (!heads.empty()) {
+        painter->setPen(QPen(snapshot.edgeColor, 3, Qt::SolidLine, Qt::RoundCap));
+        painter->drawLines(heads.data(), static_cast<int>(heads.size()));
+    }
+    if (snapshot.weighted && scale >= 0.5) {
+        QFont font;
+        font.setPointSize(13);
+        painter->setFont(font);
+        for (int e: ids)
+            painter->drawText(snapshot.lines[e].center(), QString::number(snapshot.weights[e]));
+    }
+
+    ids.clear();
+    snapshot.nodeIndex.query(query, ids);
+    if (scale < 0.2) {
+        std::vector<QRectF> dots;
+        dots.reserve(ids.size());
+        for (int id: ids) {
+            qreal r = snapshot.radii[id];
+            dots.emplace_back(snapshot.positions[id] - QPointF(r / 2, r / 2), QSizeF(r, r));
+        }
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(snapshot.nodeColor);
+        painter->drawRects(dots.data(), static_cast<int>(dots.size()));
+        return;
+    }
+    painter->setPen(QPen(Qt::black, 2, Qt::SolidLine));
+    painter->setBrush(snapshot.nodeColor);
+    for (int id: ids) {
+        qreal r = snapshot.radii[id];
+        painter->drawEllipse(QRectF(snapshot.positions[id] - QPointF(r / 2, r / 2), QSizeF(r, r)));
+    }
+    if (scale < 0.45)
+        return;
+    QFontMetrics fm(NodeGraphicsItem::labelFont());
+    painter->setFont(NodeGraphicsItem::labelFont());
+    for (int id: ids) {
+        QString text = QString::fromStdString(snapshot.names[id]);
+        painter->drawText(snapshot.positions[id] + QPointF(-fm.width(text) / 2., fm.height() / 3.), text);
+    }
+}
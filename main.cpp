@@ -1,9 +1,17 @@
 #include "mainwindow.h"
+#include "basis/headers/TaskScheduler.h"
 #include <QApplication>
+#include <QCommandLineParser>
 
 int main(int argc, char *argv[]) {
 
     QApplication a(argc, argv);
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption threads("threads", "Threads for parallel algorithms and layouts, 0 for all cores.", "count", "0");
+    parser.addOption(threads);
+    parser.process(a);
+    GraphType::TaskScheduler::setThreadCount(parser.value(threads).toInt());
     MainWindow w;
     w.show();
     return QApplication::exec();
@@ -1,7 +1,11 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
 #include "graphics/headers/GraphGraphicsView.h"
+#include "graphics/headers/QtPoint.h"
 #include "basis/headers/GraphUtils.h"
+#include "basis/headers/TreeLayout.h"
+#include "basis/headers/DistanceTable.h"
+#include "basis/headers/AlgorithmStepper.h"
 #include "widgets/headers/MultiLineInputDialog.h"
 #include "widgets/headers/MultiComboboxDialog.h"
 #include <QtGui>
@@ -9,7 +13,6 @@
 #include <QTimer>
 #include <dvninputdialog.h>
 #include <widgets/headers/GraphOptionDialog.h>
-#include "utils/qdebugstream.h"
 
 MainWindow::MainWindow(QWidget *parent) :
         QMainWindow(parent),
@@ -42,61 +45,93 @@ MainWindow::MainWindow(QWidget *parent) :
     this->_scene = new GraphGraphicsScene(_graph);
     this->_view = new GraphGraphicsView();
     this->_adjMatrix = new AdjacencyMatrixTable(_graph);
+    this->_adjHeatmap = new AdjacencyHeatmap(_graph);
     this->_incidenceMatrix = new IncidenceMatrixTable(_graph);
     this->_elementPropertiesTable = new ElementPropertiesTable(_graph);
     this->_graphPropertiesTable = new GraphPropertiesTable(_graph);
-
-    connect(_adjMatrix, SIGNAL(graphChanged()), _scene, SLOT(reload()));
-    connect(_adjMatrix, SIGNAL(graphChanged()), _incidenceMatrix, SLOT(reload()));
-    connect(_scene, SIGNAL(graphChanged()), _adjMatrix, SLOT(reload()));
-    connect(_scene, SIGNAL(graphChanged()), _incidenceMatrix, SLOT(reload()));
-    connect(this, SIGNAL(graphChanged()), _scene, SLOT(reload()));
-    connect(this, SIGNAL(graphChanged()), _adjMatrix, SLOT(reload()));
-    connect(this, SIGNAL(graphChanged()), _incidenceMatrix, SLOT(reload()));
-    connect(this, SIGNAL(graphChanged()), _view, SLOT(redraw()));
-    connect(this, SIGNAL(graphChanged()), this, SLOT(onGraphChanged()));
-    connect(_adjMatrix, SIGNAL(graphChanged()), this, SLOT(onGraphChanged()));
-    connect(_scene, SIGNAL(graphChanged()), this, SLOT(onGraphChanged()));
-    _scene->setInterval(20);
+    this->_changes = new GraphChangeBus(_graph, this);
+    this->_layout = new LayoutRunner(this);
+    this->_algorithms = new AlgorithmRunner(this);
+    this->_autosaveTimer = new QTimer(this);
+    _autosaveTimer->setInterval(30000);
+    connect(_autosaveTimer, &QTimer::timeout, this, &MainWindow::autosave);
+    _autosaveTimer->start();
+
+    connect(_changes, &GraphChangeBus::changed, _scene, &GraphGraphicsScene::applyEvents);
+    connect(_changes, &GraphChangeBus::changed, _adjMatrix, &AdjacencyMatrixTable::applyEvents);
+    connect(_changes, &GraphChangeBus::changed, _incidenceMatrix, &IncidenceMatrixTable::reload);
+    connect(_changes, &GraphChangeBus::changed, _adjHeatmap, &AdjacencyHeatmap::reload);
+    connect(_changes, &GraphChangeBus::changed, _graphPropertiesTable, &GraphPropertiesTable::onGraphChanged);
+    connect(_changes, &GraphChangeBus::changed, _elementPropertiesTable, &ElementPropertiesTable::onGraphChanged);
+    connect(_changes, &GraphChangeBus::changed, this, &MainWindow::onGraphChanged);
+    connect(_layout, &LayoutRunner::positionsChanged, _scene, &GraphGraphicsScene::moveNodes);
+    connect(_layout, &LayoutRunner::progressChanged, this, [this](int percent) {
+        _ui->statusBar->showMessage("Раскладка: " + QString::number(percent) + "%");
+    });
+    connect(_layout, &LayoutRunner::finished, this, [this](bool completed) {
+        this->_dataNeedSaving = true;
+        _ui->statusBar->showMessage(completed ? "Раскладка завершена" : "Раскладка остановлена", 3000);
+    });
+    connect(_algorithms, &AlgorithmRunner::output, this, [this](const QString &text) {
+        _ui->consoleText->moveCursor(QTextCursor::End);
+        _ui->consoleText->insertPlainText(text);
+    });
+    connect(_algorithms, &AlgorithmRunner::progressChanged, this, [this](qint64 steps) {
+        _ui->statusBar->showMessage("Алгоритм: " + QString::number(steps) + " шагов");
+    });
+    connect(_algorithms, &AlgorithmRunner::finished, this, [this](bool completed) {
+        _ui->statusBar->showMessage(completed ? "Алгоритм завершён" : "Алгоритм прерван", 3000);
+    });
+    _scene->setInterval(300);
+    this->_playbackSlider = new QSlider(Qt::Horizontal, this);
+    _playbackSlider->setMaximumWidth(200);
+    _playbackSlider->hide();
+    _ui->statusBar->addPermanentWidget(_playbackSlider);
+    connect(_playbackSlider, &QSlider::sliderMoved, this, [this](int position) {
+        this->_scene->pauseDemo();
+        this->_scene->seekDemo(position);
+    });
+    connect(_scene, &GraphGraphicsScene::demoPositionChanged, this, [this](int position, int count) {
+        _playbackSlider->setVisible(count > 0);
+        _playbackSlider->setMaximum(count);
+        if (!_playbackSlider->isSliderDown())
+            _playbackSlider->setValue(position);
+    });
 
     connect(_view, SIGNAL(unSelected()), _elementPropertiesTable, SLOT(onUnSelected()));
-    connect(this, SIGNAL(graphChanged()), _elementPropertiesTable, SLOT(onGraphChanged()));
-    connect(this, SIGNAL(graphChanged()), _graphPropertiesTable, SLOT(onGraphChanged()));
-    connect(_adjMatrix, SIGNAL(graphChanged()), _graphPropertiesTable, SLOT(onGraphChanged()));
-    connect(_scene, SIGNAL(graphChanged()), _graphPropertiesTable, SLOT(onGraphChanged()));
     connect(_view, &GraphGraphicsView::nodeSelected, _elementPropertiesTable, &ElementPropertiesTable::onNodeSelected);
     connect(_view, &GraphGraphicsView::edgeSelected, _elementPropertiesTable, &ElementPropertiesTable::onEdgeSelected);
     connect(_adjMatrix, &AdjacencyMatrixTable::edgeSelected, _elementPropertiesTable,
             &ElementPropertiesTable::onEdgeSelected);
     connect(_incidenceMatrix, &IncidenceMatrixTable::edgeSelected, _elementPropertiesTable,
             &ElementPropertiesTable::onEdgeSelected);
+    connect(_adjHeatmap, &AdjacencyHeatmap::edgeSelected, _elementPropertiesTable,
+            &ElementPropertiesTable::onEdgeSelected);
 
-    connect(this, SIGNAL(startDemoAlgorithm(std::list<std::list<std::string> >, GraphDemoFlag)), _scene,
-            SLOT(demoAlgorithm(std::list<std::list<std::string> >, GraphDemoFlag)));
-    connect(this, SIGNAL(startDemoAlgorithm(std::list<std::string>, GraphDemoFlag)), _scene,
-            SLOT(demoAlgorithm(std::list<std::string>, GraphDemoFlag)));
-    connect(this, SIGNAL(startDemoAlgorithm(std::list<std::pair<std::string, std::string> >, GraphDemoFlag)), _scene,
-            SLOT(demoAlgorithm(std::list<std::pair<std::string, std::string> >, GraphDemoFlag)));
+    connect(this, SIGNAL(startDemoAlgorithm(GraphType::NodeGroups, GraphDemoFlag)), _scene,
+            SLOT(demoAlgorithm(GraphType::NodeGroups, GraphDemoFlag)));
+    connect(this, SIGNAL(startDemoAlgorithm(GraphType::NodeSequence, GraphDemoFlag)), _scene,
+            SLOT(demoAlgorithm(GraphType::NodeSequence, GraphDemoFlag)));
+    connect(this, SIGNAL(startDemoAlgorithm(GraphType::NodePairSequence, GraphDemoFlag)), _scene,
+            SLOT(demoAlgorithm(GraphType::NodePairSequence, GraphDemoFlag)));
 
     connect(_view, &GraphGraphicsView::nodeAdded, this, [this](QPointF pos, bool auto_naming) {
         if (!auto_naming) {
             showNewNodeDialog(pos);
             return;
         }
-        this->_graph->addNode(Node(_graph->nextNodeName(), pos));
-        emit graphChanged();
+        this->_graph->addNode(Node(_graph->nextNodeName(), toPoint(pos)));
     });
     connect(_view, &GraphGraphicsView::nodeRemoved, this, [this](const std::string &node_name) {
+        // Items of an erased node must be gone before the next repaint
         if (this->_graph->removeNode(node_name))
-                emit graphChanged();
+            this->_changes->flush();
     });
     connect(_view, &GraphGraphicsView::nodeIsolated, this, [this](const std::string &node_name) {
-        if (this->_graph->isolateNode(node_name))
-                emit graphChanged();
+        this->_graph->isolateNode(node_name);
     });
     connect(_view, &GraphGraphicsView::edgeRemoved, this, [this](const std::string &uname, const std::string &vname) {
-        if (_graph->removeEdge(uname, vname))
-                emit graphChanged();
+        this->_graph->removeEdge(uname, vname);
     });
     connect(_view, &GraphGraphicsView::edgeSet, this, [this](const std::string &uname, const std::string &vname) {
         bool ok{};
@@ -109,21 +144,13 @@ MainWindow::MainWindow(QWidget *parent) :
                                       defaultValue, 1, INT_MAX, 1, &ok))
                                      : 1;
         qDebug() << w;
-        if ((ok || _graph->isUnweighted()) && this->_graph->setEdge(uname, vname, w))
-                emit graphChanged();
+        if (ok || _graph->isUnweighted())
+            this->_graph->setEdge(uname, vname, w);
     });
     connect(_view, &GraphGraphicsView::startAlgorithm, this,
             [this](const StartAlgoFlag &algo, const std::string &source_name) {
-                QDebugStream qout(std::cout, _ui->consoleText);
-                if (algo == StartAlgoFlag::BFS) {
-                    this->_ui->consoleText->clear();
-                    auto result = GraphUtils::BFSToDemo(this->_graph, source_name);
-                    emit startDemoAlgorithm(result, GraphDemoFlag::EdgeAndNode);
-                } else if (algo == StartAlgoFlag::DFS) {
-                    this->_ui->consoleText->clear();
-                    auto result = GraphUtils::DFSToDemo(this->_graph, source_name);
-                    emit startDemoAlgorithm(result, GraphDemoFlag::EdgeAndNode);
-                }
+                if (algo == StartAlgoFlag::BFS || algo == StartAlgoFlag::DFS)
+                    demoTraversal(algo == StartAlgoFlag::DFS, source_name);
             });
     connect(_view, &GraphGraphicsView::nodeEdited, this, [this](const std::string &node_name) {
         bool ok;
@@ -141,12 +168,39 @@ MainWindow::MainWindow(QWidget *parent) :
                 QMessageBox::critical(this, "Ошибка", "Это имя уже занято другой вершиной");
             else {
                 this->_graph->setNodeName(node_name, new_name.toStdString());
-                emit graphChanged();
+                this->_changes->flush();
             }
         }
     });
 
+    auto adjToolbar = new QHBoxLayout;
+    this->_adjModeBox = new QComboBox(this);
+    _adjModeBox->addItems({"Таблица", "Тепловая карта"});
+    auto orderingBox = new QComboBox(this);
+    orderingBox->addItems({"Порядок: по имени", "Порядок: по степени", "Порядок: обратный Катхилла-Макки"});
+    orderingBox->setEnabled(false);
+    auto colorBox = new QComboBox(this);
+    colorBox->addItems({"Цвет: плотность", "Цвет: вес"});
+    colorBox->setEnabled(false);
+    adjToolbar->addWidget(_adjModeBox);
+    adjToolbar->addWidget(orderingBox);
+    adjToolbar->addWidget(colorBox);
+    adjToolbar->addStretch();
+    connect(_adjModeBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this,
+            [this, orderingBox, colorBox](int index) {
+                bool heatmap = index == 1;
+                this->_adjMatrix->setVisible(!heatmap);
+                this->_adjHeatmap->setVisible(heatmap);
+                orderingBox->setEnabled(heatmap);
+                colorBox->setEnabled(heatmap);
+            });
+    connect(orderingBox, SIGNAL(currentIndexChanged(int)), _adjHeatmap, SLOT(setOrdering(int)));
+    connect(colorBox, SIGNAL(currentIndexChanged(int)), _adjHeatmap, SLOT(setColorMode(int)));
+    _ui->adjMatLayout->addLayout(adjToolbar);
     _ui->adjMatLayout->addWidget(this->_adjMatrix, 0, Qt::AlignCenter);
+    _ui->adjMatLayout->addWidget(this->_adjHeatmap, 1);
+    this->_adjHeatmap->hide();
+    _ui->incMatLayout->addWidget(this->_incidenceMatrix, 0, Qt::AlignCenter);
     auto gLabel = new QLabel(this);
     gLabel->setText("Свойства графа");
     _ui->propertiesLayout->addWidget(gLabel);
@@ -163,13 +217,23 @@ MainWindow::MainWindow(QWidget *parent) :
 }
 
 void MainWindow::resetGraph(Graph *graph) {
+    this->_layout->abandon();
+    this->_algorithms->cancel();
+    this->_savedArrangement.clear();
+    _ui->actionRestoreLayout->setEnabled(false);
+    this->_changes->setGraph(graph);
     delete this->_graph;
     this->_graph = graph;
     this->_scene->setGraph(_graph);
     this->_adjMatrix->setGraph(_graph);
+    this->_adjHeatmap->setGraph(_graph);
+    if (_graph->countNodes() > 2000)
+        this->_adjModeBox->setCurrentIndex(1);
     this->_incidenceMatrix->setGraph(_graph);
     this->_elementPropertiesTable->setGraph(_graph);
     this->_graphPropertiesTable->setGraph(_graph);
+    _ui->statusBar->clearMessage();
+    _ui->consoleText->clear();
 }
 
 void MainWindow::initWorkspace(const QString &filename, bool new_file) {
@@ -184,8 +248,14 @@ void MainWindow::initWorkspace(const QString &filename, bool new_file) {
                 if (reply == QMessageBox::Cancel)
                     return;
             }
-            resetGraph(new Graph(Graph::readFromFile(filename.toStdString())));
-            this->_dataNeedSaving = false;
+            // An autosave newer than the file is left over from a session that did not end cleanly
+            QFileInfo autosaved(autosaveFilename(filename));
+            bool restore = autosaved.exists() && autosaved.lastModified() > QFileInfo(filename).lastModified()
+                           && QMessageBox::question(this, "Автосохранение",
+                                                    "Найдены несохранённые изменения. Восстановить их?",
+                                                    QMessageBox::Yes | QMessageBox::No) == QMessageBox::Yes;
+            resetGraph(new Graph(Graph::readFromFile((restore ? autosaved.filePath() : filename).toStdString())));
+            this->_dataNeedSaving = restore;
         } else {
             bool weighted, directed, ok;
             int node_num;
@@ -194,7 +264,6 @@ void MainWindow::initWorkspace(const QString &filename, bool new_file) {
             this->_dataNeedSaving = true;
             resetGraph(new Graph(node_num, directed, weighted));
         }
-        emit graphChanged();
     }
     catch (...) {
         setWorkspaceEnabled(false);
@@ -212,7 +281,9 @@ void MainWindow::initWorkspace(const QString &filename, bool new_file) {
 }
 
 MainWindow::~MainWindow() {
+    this->_autosave.waitForFinished();
     delete _ui;
+    this->_changes->setGraph(nullptr);
     delete _graph;
     delete _scene;
     delete _view;
@@ -230,6 +301,31 @@ void MainWindow::closeEvent(QCloseEvent *event) {
         else if (reply == QMessageBox::Cancel)
             event->ignore();
     }
+    if (event->isAccepted())
+        discardAutosave();
+}
+
+QString MainWindow::autosaveFilename(const QString &filename) {
+    return filename + ".autosave";
+}
+
+void MainWindow::autosave() {
+    if (!_dataNeedSaving || _workingFilename.isEmpty() || _autosave.isRunning())
+        return;
+    // Writing goes on beside the editing, from the version of the moment
+    auto snapshot = _graph->snapshot();
+    auto file = autosaveFilename(_workingFilename);
+    this->_autosave = QtConcurrent::run([snapshot, file]() {
+        Graph::writeToFile((file + ".tmp").toStdString(), snapshot);
+        QFile::remove(file);
+        QFile::rename(file + ".tmp", file);
+    });
+}
+
+void MainWindow::discardAutosave() {
+    this->_autosave.waitForFinished();
+    if (!_workingFilename.isEmpty())
+        QFile::remove(autosaveFilename(_workingFilename));
 }
 
 QString MainWindow::showOpenFileDialog() {
@@ -272,12 +368,10 @@ void MainWindow::showNewNodeDialog(QPointF pos) {
                                                  tr("Длина имени не должно превышать больше 3 символов и не может быть меньше 1"));
             return;
         }
-        Node newNode(newNodeName.toStdString(), pos);
+        Node newNode(newNodeName.toStdString(), toPoint(pos));
         bool succeeded = _graph->addNode(newNode);
         if (!succeeded)
             QMessageBox::critical(this, "Ошибка", "Это имя уже используется для другой вершины");
-        else
-                emit graphChanged();
     }
 }
 
@@ -316,6 +410,7 @@ void MainWindow::on_actionSave_triggered() {
     if (_dataNeedSaving) {
         this->_dataNeedSaving = false;
         Graph::writeToFile(_workingFilename.toStdString(), *_graph);
+        discardAutosave();
         _ui->statusBar->showMessage("Успешно сохранено");
         QTimer::singleShot(2000, this, [this]() {
             this->_ui->statusBar->clearMessage();
@@ -365,9 +460,7 @@ void MainWindow::on_actionAddEdge_triggered() {
     QRegExp re("\\d*");
     if (ok && !list.empty() && re.exactMatch(list[2])) {
         bool succeeded = _graph->setEdge(list[0].toStdString(), list[1].toStdString(), list[2].toInt());
-        if (succeeded)
-                emit graphChanged();
-        else
+        if (!succeeded)
             QMessageBox::critical(this, "Ошибка", "Нельзя создать такое ребро!");
     }
 }
@@ -383,10 +476,8 @@ void MainWindow::on_actionEditEdge_triggered() {
     if (ok && !list.empty() && re.exactMatch(list[2])) {
         if (_graph->hasEdge(list[0].toStdString(), list[1].toStdString())) {
             bool succeeded = _graph->setEdge(list[0].toStdString(), list[1].toStdString(), list[2].toInt());
-            if (succeeded) {
-                emit graphChanged();
+            if (succeeded)
                 return;
-            }
         }
         QMessageBox::critical(this, "Ошибка", "Здесь нет такого ребра!");
     }
@@ -400,7 +491,7 @@ void MainWindow::on_actionDelNode_triggered() {
         if (!succeeded)
             QMessageBox::critical(this, "Ошибка", "Несуществует такой вершины!");
         else
-                emit graphChanged();
+            this->_changes->flush();
     }
 }
 
@@ -412,13 +503,115 @@ void MainWindow::on_actionDelEdge_triggered() {
     QList<QString> list = MultiLineInputDialog::getStrings(this, "Удалить ребро", labelText, &ok);
     if (ok && !list.empty()) {
         bool succeeded = _graph->removeEdge(list[0].toStdString(), list[1].toStdString());
-        if (succeeded)
-                emit graphChanged();
-        else
+        if (!succeeded)
             QMessageBox::critical(this, "Ошибка", "Между этими вершинами нет ребра!");
     }
 }
 
+void MainWindow::on_actionForceLayout_triggered() {
+    this->_layout->start(_graph, LayoutRunner::forceDirected());
+}
+
+void MainWindow::on_actionMultilevelLayout_triggered() {
+    this->_layout->start(_graph, LayoutRunner::multilevel());
+}
+
+void MainWindow::on_actionLayeredLayout_triggered() {
+    this->_layout->start(_graph, LayoutRunner::layered(), false);
+}
+
+void MainWindow::on_actionStopLayout_triggered() {
+    this->_layout->cancel();
+}
+
+void MainWindow::on_actionTreeLayout_triggered() {
+    arrangeTree(false);
+}
+
+void MainWindow::on_actionRadialTreeLayout_triggered() {
+    arrangeTree(true);
+}
+
+void MainWindow::arrangeTree(bool radial) {
+    QStringList trees{"Остовное дерево (в ширину)", "Остовное дерево (в глубину)",
+                      "Минимальное остовное дерево (Прим)", "Обход в ширину"};
+    bool ok{};
+    auto tree = QInputDialog::getItem(this, "Раскладка дерева", "Дерево", trees, 0, false, &ok);
+    if (!ok)
+        return;
+    QStringList items;
+    for (auto node: _graph->nodeList())
+        items.append(QString::fromStdString(node->name()));
+    auto source_str = QInputDialog::getItem(this, "Начальная вершина:", "Имя", items, 0, false, &ok);
+    if (!ok || source_str.isNull())
+        return;
+    auto source = source_str.toStdString();
+    _ui->consoleText->clear();
+    int kind = trees.indexOf(tree);
+    auto arrange = [this, radial, source](const NodePairSequence &edges) {
+        if (edges.empty() || _graph->node(source) == nullptr)
+            return;
+        TreeLayout::Options options;
+        options.radial = radial;
+        TreeLayout layout(edges, options);
+        std::vector<double> x, y;
+        layout.run(x, y);
+
+        this->_layout->abandon();
+        if (_savedArrangement.empty()) {
+            for (auto node: _graph->nodeList())
+                this->_savedArrangement[node->name()] = toQPointF(node->euclidePos());
+            _ui->actionRestoreLayout->setEnabled(true);
+        }
+        // The root stays where it is, nodes outside the tree are left alone
+        QPointF origin = toQPointF(_graph->node(source)->euclidePos());
+        std::vector<Node *> nodes;
+        std::vector<QPointF> positions;
+        for (size_t i = 0; i < x.size(); ++i) {
+            auto node = _graph->node(edges.name(layout.nodes()[i]));
+            if (node == nullptr)
+                continue;
+            nodes.push_back(node);
+            positions.push_back(origin + QPointF(x[i], y[i]));
+        }
+        this->_scene->animateNodes(nodes, positions);
+        this->_dataNeedSaving = true;
+    };
+    if (kind == 3) {
+        _algorithms->startOnSnapshot(_graph, [source](const GraphSnapshot &graph) {
+            return GraphUtils::BFSTree(graph, source);
+        }, arrange);
+        return;
+    }
+    _algorithms->start(_graph, [kind, source](const Graph *graph) {
+        switch (kind) {
+            case 0:
+                return GraphUtils::spanningTreeBFS(graph, source);
+            case 1:
+                return GraphUtils::spanningTreeDFS(graph, source);
+            default:
+                return GraphUtils::Prim(graph, source);
+        }
+    }, arrange);
+}
+
+void MainWindow::on_actionRestoreLayout_triggered() {
+    std::vector<Node *> nodes;
+    std::vector<QPointF> positions;
+    for (const auto &it: _savedArrangement) {
+        auto node = _graph->node(it.first);
+        if (node == nullptr)
+            continue;
+        nodes.push_back(node);
+        positions.push_back(it.second);
+    }
+    this->_savedArrangement.clear();
+    _ui->actionRestoreLayout->setEnabled(false);
+    this->_layout->abandon();
+    this->_scene->animateNodes(nodes, positions);
+    this->_dataNeedSaving = true;
+}
+
 void MainWindow::on_BFSbtn_clicked() {
     _ui->consoleText->clear();
     bool ok{};
@@ -431,9 +624,7 @@ void MainWindow::on_BFSbtn_clicked() {
             return;
         auto source = _graph->node(source_str.toStdString());
         if (_graph->hasNode(source)) {
-            QDebugStream qout(std::cout, _ui->consoleText);
-            auto result = GraphUtils::BFSToDemo(_graph, source->name());
-            emit startDemoAlgorithm(result, GraphDemoFlag::EdgeAndNode);
+            demoTraversal(false, source->name());
         } else {
             QMessageBox::critical(this, "Ошибка", tr("Вершина не названа ") + source_str);
         }
@@ -452,20 +643,60 @@ void MainWindow::on_DFSbtn_clicked() {
             return;
         auto source = _graph->node(source_str.toStdString());
         if (_graph->hasNode(source)) {
-            QDebugStream qout(std::cout, _ui->consoleText);
-            auto result = GraphUtils::DFSToDemo(_graph, source->name());
-            emit startDemoAlgorithm(result, GraphDemoFlag::EdgeAndNode);
+            demoTraversal(true, source->name());
         } else
             QMessageBox::critical(this, "Ошибка", tr("Веришна не названа ") + source_str);
     }
 }
 
+void MainWindow::demoTraversal(bool depth_first, const std::string &source) {
+    _ui->consoleText->clear();
+    // A huge graph is shown while it is traversed instead of after
+    if (_graph->countNodes() > _stepwiseThreshold) {
+        std::unique_ptr<AlgorithmStepper> stepper;
+        if (depth_first)
+            stepper.reset(new DFSStepper(_graph, source));
+        else
+            stepper.reset(new BFSStepper(_graph, source));
+        this->_scene->demoStepwise(std::move(stepper), GraphDemoFlag::EdgeAndNode);
+        return;
+    }
+    _algorithms->startOnSnapshot(_graph, [depth_first, source](const GraphSnapshot &graph) {
+        return depth_first ? GraphUtils::DFSToDemo(graph, source) : GraphUtils::BFSToDemo(graph, source);
+    }, [this](const NodePairSequence &result) {
+        emit startDemoAlgorithm(result, GraphDemoFlag::EdgeAndNode);
+    });
+}
+
+void MainWindow::demoGrowingTree(bool spanning) {
+    bool ok{};
+    QStringList items;
+    for (auto node: _graph->nodeList())
+        items.append(QString::fromStdString(node->name()));
+    auto source = QInputDialog::getItem(this, "Начальная вершина:", "Имя", items, 0, false, &ok);
+    if (!ok || source.isNull())
+        return;
+    _ui->consoleText->clear();
+    std::unique_ptr<AlgorithmStepper> stepper(new DijkstraStepper(_graph, source.toStdString(), spanning));
+    this->_scene->demoStepwise(std::move(stepper), GraphDemoFlag::EdgeAndNode);
+}
+
+void MainWindow::on_actionShortestPathTree_triggered() {
+    demoGrowingTree(false);
+}
+
+void MainWindow::on_actionMinimumSpanningTree_triggered() {
+    demoGrowingTree(true);
+}
+
 void MainWindow::on_EulerBtn_clicked() {
 
     _ui->consoleText->clear();
-    QDebugStream qout(std::cout, _ui->consoleText);
-    auto result = GraphUtils::displayAllEulerianCircuits(_graph);
-    emit startDemoAlgorithm(result, GraphDemoFlag::EdgeAndNode);
+    _algorithms->start(_graph, [](const Graph *graph) {
+        return GraphUtils::displayAllEulerianCircuits(graph);
+    }, [this](const NodeGroups &result) {
+        emit startDemoAlgorithm(result, GraphDemoFlag::EdgeAndNode);
+    });
 }
 
 
@@ -484,6 +715,97 @@ void MainWindow::on_actionEuler_Cycle_triggered() {
 }
 
 
+void MainWindow::on_actionDistanceTable_triggered() {
+    bool ok{};
+    QList<QString> labelText;
+    labelText.push_back("Источники (пусто - все): ");
+    labelText.push_back("Цели (пусто - все): ");
+    QList<QString> list = MultiLineInputDialog::getStrings(this, "Таблица расстояний", labelText, &ok);
+    if (!ok || list.size() < 2)
+        return;
+    auto names = [this](const QString &text) {
+        std::vector<std::string> result;
+        for (const auto &name: text.split(QRegExp("[\\s,;]+"), QString::SkipEmptyParts))
+            result.push_back(name.toStdString());
+        if (result.empty()) {
+            for (auto node: _graph->nodeList())
+                result.push_back(node->name());
+        }
+        return result;
+    };
+    auto sources = names(list[0]), targets = names(list[1]);
+    auto all = sources;
+    all.insert(all.end(), targets.begin(), targets.end());
+    for (const auto &name: all) {
+        if (!_graph->hasNode(name)) {
+            QMessageBox::critical(this, "Ошибка", tr("Нет вершины ") + QString::fromStdString(name));
+            return;
+        }
+    }
+    _ui->consoleText->clear();
+    _algorithms->start(_graph, [sources, targets](const Graph *graph) {
+        return GraphUtils::distanceTable(graph, sources, targets);
+    }, [this, sources, targets](const std::vector<long long> &distances) {
+        // Large tables do not fit the console, they can go to a file instead
+        if (sources.size() <= 100 && targets.size() <= 100)
+            return;
+        auto filename = QFileDialog::getSaveFileName(this, tr("Сохранить таблицу"), QDir::currentPath(),
+                                                     tr("Таблицы CSV (*.csv)"), nullptr,
+                                                     QFileDialog::DontUseNativeDialog);
+        if (filename.isEmpty())
+            return;
+        std::ofstream os(filename.toStdString());
+        for (const auto &target: targets)
+            os << ";" << target;
+        os << "\n";
+        for (size_t i = 0; i < sources.size(); ++i) {
+            os << sources[i];
+            for (size_t j = 0; j < targets.size(); ++j) {
+                os << ";";
+                if (distances[i * targets.size() + j] != GraphType::DistanceTable::unreachable)
+                    os << distances[i * targets.size() + j];
+            }
+            os << "\n";
+        }
+        if (!os)
+            QMessageBox::critical(this, "Ошибка", tr("Не удалось сохранить ") + filename);
+    });
+}
+
+void MainWindow::on_actionCancelAlgorithm_triggered() {
+    this->_algorithms->cancel();
+}
+
+void MainWindow::on_actionDemoPlay_triggered() {
+    if (_scene->demoPlaying())
+        this->_scene->pauseDemo();
+    else
+        this->_scene->playDemo();
+}
+
+void MainWindow::on_actionDemoStepForward_triggered() {
+    this->_scene->stepDemo(1);
+}
+
+void MainWindow::on_actionDemoStepBack_triggered() {
+    this->_scene->stepDemo(-1);
+}
+
+void MainWindow::on_actionDemoReverse_toggled(bool checked) {
+    this->_scene->setDemoReversed(checked);
+}
+
+void MainWindow::on_actionDemoFaster_triggered() {
+    this->_scene->setDemoSpeed(_scene->demoSpeed() * 2);
+    _ui->statusBar->showMessage("Скорость: x" + QString::number(_scene->demoSpeed()), 3000);
+}
+
+void MainWindow::on_actionDemoSlower_triggered() {
+    this->_scene->setDemoSpeed(_scene->demoSpeed() / 2);
+    _ui->statusBar->showMessage("Скорость: x" + QString::number(_scene->demoSpeed()), 3000);
+}
+
+
 void MainWindow::on_tabWidget_currentChanged(int index) {
     _elementPropertiesTable->onUnSelected();
 }
@@ -492,32 +814,36 @@ void MainWindow::on_tabWidget_currentChanged(int index) {
 //void MainWindow::on_isFull_clicked()
 //{
 //    _ui->consoleText->clear();
-//    _ui->consoleText->append(GraphUtils::isFull(this->_graph));
+//    _ui->consoleText->append(QString::fromStdString(GraphUtils::isFull(this->_graph)));
 //}
 
 //void MainWindow::on_sum_clicked()
 //{
 //    _ui->consoleText->clear();
-//    _ui->consoleText->append(GraphUtils::SummaryOfAllNodesDegrees(this->_graph));
+//    _ui->consoleText->append(QString::fromStdString(GraphUtils::SummaryOfAllNodesDegrees(this->_graph)));
 //}
 
 void MainWindow::on_dVN_clicked()
 {
-    std::unordered_map<std::string, bool> visited;
-    std::list<std::string> vertexes;
     int radix{};
     QStringList items;
     for (auto node: _graph->nodeList())
         items.append(QString::fromStdString(node->name()));
     auto source = DVNINPUTDIALOG::initDVN(this,items,radix);
-    GraphUtils::DFSRadix(_graph, source, visited, vertexes, radix);
-    QString list;
-    QString space = " ";
-    std::for_each(vertexes.begin(), vertexes.end(), [&list, &space](auto &el){
-        list.append(QString::fromStdString(el));
-        list.append(space);
-    });
     _ui->consoleText->clear();
-    _ui->consoleText->append("Нач. вершина (" + QString::fromStdString(source) + "):");
-    _ui->consoleText->append(list);
+    _algorithms->start(_graph, [source, radix](const Graph *graph) {
+        std::unordered_map<std::string, bool> visited;
+        std::list<std::string> vertexes;
+        GraphUtils::DFSRadix(graph, source, visited, vertexes, radix);
+        return vertexes;
+    }, [this, source](const std::list<std::string> &vertexes) {
+        QString list;
+        QString space = " ";
+        std::for_each(vertexes.begin(), vertexes.end(), [&list, &space](auto &el){
+            list.append(QString::fromStdString(el));
+            list.append(space);
+        });
+        _ui->consoleText->append("Нач. вершина (" + QString::fromStdString(source) + "):");
+        _ui->consoleText->append(list);
+    });
 }
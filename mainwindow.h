@@ -8,8 +8,12 @@
 #include "basis/headers/Graph.h"
 #include "graphics/headers/GraphGraphicsScene.h"
 #include "widgets/headers/AdjacencyMatrixTable.h"
+#include "widgets/headers/AdjacencyHeatmap.h"
 #include "graphics/headers/GraphGraphicsView.h"
 #include "widgets/headers/ElementPropertiesTable.h"
+#include "utils/GraphChangeBus.h"
+#include "utils/LayoutRunner.h"
+#include "utils/AlgorithmRunner.h"
 
 namespace Ui {
     class MainWindow;
@@ -53,6 +57,20 @@ private slots:
 
     void on_actionDelEdge_triggered();
 
+    void on_actionForceLayout_triggered();
+
+    void on_actionMultilevelLayout_triggered();
+
+    void on_actionLayeredLayout_triggered();
+
+    void on_actionStopLayout_triggered();
+
+    void on_actionTreeLayout_triggered();
+
+    void on_actionRadialTreeLayout_triggered();
+
+    void on_actionRestoreLayout_triggered();
+
     void on_BFSbtn_clicked();
 
     void on_DFSbtn_clicked();
@@ -65,6 +83,26 @@ private slots:
 
     void on_actionEuler_Cycle_triggered();
 
+    void on_actionDistanceTable_triggered();
+
+    void on_actionShortestPathTree_triggered();
+
+    void on_actionMinimumSpanningTree_triggered();
+
+    void on_actionCancelAlgorithm_triggered();
+
+    void on_actionDemoPlay_triggered();
+
+    void on_actionDemoStepForward_triggered();
+
+    void on_actionDemoStepBack_triggered();
+
+    void on_actionDemoReverse_toggled(bool checked);
+
+    void on_actionDemoFaster_triggered();
+
+    void on_actionDemoSlower_triggered();
+
     void on_tabWidget_currentChanged(int index);
 
 //    void on_isFull_clicked();
@@ -73,15 +111,15 @@ private slots:
 
     void on_dVN_clicked();
 
-signals:
+    void autosave();
 
-    void graphChanged();
+signals:
 
-    void startDemoAlgorithm(std::list<std::pair<std::string, std::string>> listOfPair, GraphDemoFlag flag);
+    void startDemoAlgorithm(GraphType::NodePairSequence pairs, GraphDemoFlag flag);
 
-    void startDemoAlgorithm(std::list<std::string> listOfNum, GraphDemoFlag flag);
+    void startDemoAlgorithm(GraphType::NodeSequence nodes, GraphDemoFlag flag);
 
-    void startDemoAlgorithm(std::list<std::list<std::string>> listOfList, GraphDemoFlag flag);
+    void startDemoAlgorithm(GraphType::NodeGroups groups, GraphDemoFlag flag);
 
 protected:
     void closeEvent(QCloseEvent *event) override;
@@ -92,11 +130,24 @@ private:
     GraphGraphicsScene *_scene;
     GraphGraphicsView *_view;
     AdjacencyMatrixTable *_adjMatrix;
+    AdjacencyHeatmap *_adjHeatmap;
+    QComboBox *_adjModeBox;
     IncidenceMatrixTable *_incidenceMatrix;
     ElementPropertiesTable *_elementPropertiesTable;
     GraphPropertiesTable *_graphPropertiesTable;
     GraphType::Graph *_graph;
+    GraphChangeBus *_changes;
+    LayoutRunner *_layout;
+    AlgorithmRunner *_algorithms;
     bool _dataNeedSaving;
+    QTimer *_autosaveTimer;
+    QFuture<void> _autosave;
+    // Seeks the demo being played
+    QSlider *_playbackSlider;
+    // Positions from before the last tree arrangement, to switch back to
+    std::unordered_map<std::string, QPointF> _savedArrangement;
+    // Traversals of larger graphs are shown step by step while they run
+    static constexpr int _stepwiseThreshold = 20000;
 
     QString showOpenFileDialog();
 
@@ -106,9 +157,21 @@ private:
 
     void setWorkspaceEnabled(bool ready);
 
+    void demoTraversal(bool depth_first, const std::string &source);
+
+    // Dijkstra's shortest path tree, or Prim's minimum spanning tree with `spanning`, growing from a node
+    void demoGrowingTree(bool spanning);
+
     void initWorkspace(const QString &filename, bool new_file = false);
 
     void resetGraph(GraphType::Graph *graph);
+
+    void arrangeTree(bool radial);
+
+    static QString autosaveFilename(const QString &filename);
+
+    // Waits for a running autosave and removes the file, the graph has been saved or dropped
+    void discardAutosave();
 };
 
 #endif // MAINWINDOW_H
@@ -0,0 +1,132 @@
+#ifndef ALGORITHMRUNNER_H
+#define ALGORITHMRUNNER_H
+
+#include "basis/headers/Graph.h"
+#include "basis/headers/AlgorithmContext.h"
+#include <QObject>
+#include <QTimer>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <iostream>
+#include <memory>
+#include <type_traits>
+
+/*
+ * Runs GraphUtils algorithms on the thread pool against the version of the graph the job
+ * was started on: a snapshot is taken on the GUI thread and read by the job on the worker,
+ * or turned into a graph of the job's own there, so editing can go on meanwhile. What the
+ * algorithm prints goes to output(), progress is polled once per frame from the job's
+ * step counter, and the result is handed to the callback on the GUI thread unless the
+ * job was cancelled or replaced by a newer one.
+ */
+class AlgorithmRunner : public QObject {
+Q_OBJECT
+public:
+    explicit AlgorithmRunner(QObject *parent = nullptr) : QObject(parent), _output(std::cout.rdbuf()) {
+        std::cout.rdbuf(&_output);
+        _pollTimer.setInterval(16);
+        connect(&_pollTimer, &QTimer::timeout, this, &AlgorithmRunner::poll);
+    }
+
+    ~AlgorithmRunner() override {
+        cancel();
+        for (auto &future: _futures)
+            future.waitForFinished();
+        std::cout.rdbuf(_output.fallback());
+    }
+
+    bool isRunning() const { return _context != nullptr; }
+
+    // `job` gets the copy of the graph, `done` its result
+    template<typename Job, typename Done>
+    void start(const GraphType::Graph *graph, Job job, Done done) {
+        startOnSnapshot(graph, [job](const GraphType::GraphSnapshot &snapshot) {
+            GraphType::Graph copy(snapshot);
+            return job(&copy);
+        }, done);
+    }
+
+    // `job` reads the snapshot itself, for algorithms that need no Graph
+    template<typename Job, typename Done>
+    void startOnSnapshot(const GraphType::Graph *graph, Job job, Done done) {
+        typedef typename std::decay<decltype(job(graph->snapshot()))>::type Result;
+        cancel();
+        auto snapshot = graph->snapshot();
+        auto context = std::make_shared<GraphType::AlgorithmContext>();
+        auto result = std::make_shared<Result>();
+        auto completed = std::make_shared<bool>(false);
+        this->_context = context;
+        auto watcher = new QFutureWatcher<void>(this);
+        connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, context, result, completed, done]() {
+            watcher->deleteLater();
+            if (context != _context)
+                return;
+            poll();
+            _pollTimer.stop();
+            this->_context.reset();
+            if (*completed)
+                done(*result);
+            emit finished(*completed);
+        });
+        auto future = QtConcurrent::run([snapshot, context, job, result, completed]() {
+            GraphType::AlgorithmContext::Scope scope(context.get());
+            try {
+                *result = job(snapshot);
+                *completed = true;
+            } catch (const GraphType::AlgorithmCancelled &) {
+            } catch (const char *error) {
+                std::cout << error << std::endl;
+            }
+        });
+        watcher->setFuture(future);
+        prune();
+        _futures.append(future);
+        _pollTimer.start();
+        emit progressChanged(0);
+    }
+
+public slots:
+
+    // A replaced or cancelled job stops at its next step and its result is dropped
+    void cancel() {
+        if (_context == nullptr)
+            return;
+        _context->cancel();
+        poll();
+        _pollTimer.stop();
+        this->_context.reset();
+        emit finished(false);
+    }
+
+signals:
+
+    void output(const QString &text);
+
+    void progressChanged(qint64 steps);
+
+    void finished(bool completed);
+
+private:
+    GraphType::AlgorithmContext::Output _output;
+    std::shared_ptr<GraphType::AlgorithmContext> _context;
+    QList<QFuture<void>> _futures;
+    QTimer _pollTimer;
+
+    void poll() {
+        if (_context == nullptr)
+            return;
+        auto text = _context->takeOutput();
+        if (!text.empty())
+            emit output(QString::fromStdString(text));
+        emit progressChanged(_context->steps());
+    }
+
+    void prune() {
+        for (int i = _futures.size() - 1; i >= 0; --i) {
+            if (_futures[i].isFinished())
+                _futures.removeAt(i);
+        }
+    }
+};
+
+#endif // ALGORITHMRUNNER_H
@@ -0,0 +1,62 @@
+#ifndef GRAPHCHANGEBUS_H
+#define GRAPHCHANGEBUS_H
+
+#include "basis/headers/Graph.h"
+#include <QObject>
+#include <vector>
+
+/*
+ * Delivers the change journal of a graph to the views.
+ * Every edit made during one event loop turn is sent as a single batch,
+ * so listeners apply the deltas once instead of rebuilding after every edit.
+ */
+class GraphChangeBus : public QObject {
+Q_OBJECT
+public:
+    explicit GraphChangeBus(GraphType::Graph *graph = nullptr, QObject *parent = nullptr) : QObject(parent) {
+        setGraph(graph);
+    }
+
+    ~GraphChangeBus() override {
+        if (_graph != nullptr)
+            _graph->setChangeHandler(nullptr);
+    }
+
+    // Pending changes of the previous graph are dropped, call it before deleting that graph
+    void setGraph(GraphType::Graph *graph) {
+        if (_graph != nullptr)
+            _graph->setChangeHandler(nullptr);
+        this->_graph = graph;
+        if (_graph != nullptr)
+            _graph->setChangeHandler([this]() { schedule(); });
+    }
+
+    GraphType::Graph *graph() const { return this->_graph; }
+
+public slots:
+
+    void flush() {
+        this->_scheduled = false;
+        if (_graph == nullptr)
+            return;
+        auto events = _graph->takeEvents();
+        if (!events.empty())
+            emit changed(events);
+    }
+
+signals:
+
+    void changed(const std::vector<GraphType::GraphEvent> &events);
+
+private:
+    GraphType::Graph *_graph{};
+    bool _scheduled = false;
+
+    void schedule() {
+        if (_scheduled) return;
+        this->_scheduled = true;
+        QMetaObject::invokeMethod(this, "flush", Qt::QueuedConnection);
+    }
+};
+
+#endif // GRAPHCHANGEBUS_H
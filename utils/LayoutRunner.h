@@ -0,0 +1,201 @@
+#ifndef LAYOUTRUNNER_H
+#define LAYOUTRUNNER_H
+
+#include "basis/headers/CompactGraph.h"
+#include "basis/headers/ForceLayout.h"
+#include "basis/headers/LayeredLayout.h"
+#include "basis/headers/LayoutMonitor.h"
+#include "basis/headers/MultilevelLayout.h"
+#include <QObject>
+#include <QTimer>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*
+ * Runs a layout job on a worker thread and streams its intermediate positions
+ * back to the GUI thread at most once per frame. The job only sees a compact
+ * copy of the graph and plain coordinate arrays; positions are applied to the
+ * nodes on the GUI thread, and dropped if the graph structure changed meanwhile.
+ */
+class LayoutRunner : public QObject {
+Q_OBJECT
+public:
+    // Shared by the job and the runner, the job calls it from the worker thread
+    class Control : public GraphType::LayoutMonitor {
+    public:
+        bool cancelled() const override { return _cancelled; }
+
+        void progress(int percent) override { this->_progress = percent; }
+
+        bool wantsFrame() const override { return _frameWanted; }
+
+        // Copies the positions only when the previous frame has been shown
+        void frame(const std::vector<double> &x, const std::vector<double> &y) override {
+            if (!_frameWanted)
+                return;
+            std::lock_guard<std::mutex> lock(_mutex);
+            this->_x = x;
+            this->_y = y;
+            this->_frameWanted = false;
+        }
+
+    private:
+        friend class LayoutRunner;
+
+        std::atomic<bool> _cancelled{false};
+        std::atomic<int> _progress{0};
+        std::atomic<bool> _frameWanted{true};
+        std::mutex _mutex;
+        std::vector<double> _x, _y;
+    };
+
+    typedef std::function<void(const GraphType::CompactGraph &, std::vector<double> &, std::vector<double> &,
+                               Control &)> Job;
+
+    explicit LayoutRunner(QObject *parent = nullptr) : QObject(parent) {
+        _frameTimer.setInterval(16);
+        connect(&_frameTimer, &QTimer::timeout, this, &LayoutRunner::showFrame);
+    }
+
+    ~LayoutRunner() override {
+        abandon();
+    }
+
+    bool isRunning() const { return _control != nullptr; }
+
+    // Waits for a running job and throws its result away, e.g. before the graph is deleted
+    void abandon() {
+        if (_control == nullptr)
+            return;
+        _control->_cancelled = true;
+        _frameTimer.stop();
+        this->_control.reset();
+        _future.waitForFinished();
+    }
+
+    // Layouts that care about edge direction pass `symmetric` false
+    void start(GraphType::Graph *graph, const Job &job, bool symmetric = true) {
+        abandon();
+        this->_graph = graph;
+        this->_version = graph->version();
+        auto compact = std::make_shared<const GraphType::CompactGraph>(*graph, symmetric);
+        this->_nodes = compact->nodes();
+        auto control = std::make_shared<Control>();
+        this->_control = control;
+        auto x = std::make_shared<std::vector<double>>(_nodes.size());
+        auto y = std::make_shared<std::vector<double>>(_nodes.size());
+        for (size_t i = 0; i < _nodes.size(); ++i) {
+            (*x)[i] = _nodes[i]->euclidePos().x();
+            (*y)[i] = _nodes[i]->euclidePos().y();
+        }
+        auto watcher = new QFutureWatcher<void>(this);
+        connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, control, x, y]() {
+            watcher->deleteLater();
+            if (control != _control)
+                return;
+            _frameTimer.stop();
+            bool completed = !control->cancelled();
+            if (!apply(*x, *y))
+                completed = false;
+            this->_control.reset();
+            emit progressChanged(100);
+            emit finished(completed);
+        });
+        this->_future = QtConcurrent::run([compact, control, job, x, y]() {
+            job(*compact, *x, *y, *control);
+        });
+        watcher->setFuture(_future);
+        _frameTimer.start();
+        emit progressChanged(0);
+    }
+
+    static Job forceDirected(const GraphType::ForceLayout::Options &options = GraphType::ForceLayout::Options()) {
+        return [options](const GraphType::CompactGraph &graph, std::vector<double> &x, std::vector<double> &y,
+                         Control &control) {
+            GraphType::ForceLayout::fit(x, y, options.idealLength);
+            GraphType::ForceLayout layout(graph, x, y, options);
+            while (!control.cancelled() && layout.step()) {
+                control.progress(100 * layout.iteration() / options.iterations);
+                control.frame(layout.x(), layout.y());
+            }
+            x = layout.x();
+            y = layout.y();
+        };
+    }
+
+    static Job multilevel(const GraphType::MultilevelLayout::Options &options = GraphType::MultilevelLayout::Options()) {
+        return [options](const GraphType::CompactGraph &graph, std::vector<double> &x, std::vector<double> &y,
+                         Control &control) {
+            GraphType::MultilevelLayout layout(graph, options);
+            layout.run(x, y, control);
+        };
+    }
+
+    // Needs a graph started without `symmetric`
+    static Job layered(const GraphType::LayeredLayout::Options &options = GraphType::LayeredLayout::Options()) {
+        return [options](const GraphType::CompactGraph &graph, std::vector<double> &x, std::vector<double> &y,
+                         Control &control) {
+            GraphType::LayeredLayout layout(graph, options);
+            layout.run(x, y, control);
+        };
+    }
+
+public slots:
+
+    // The job stops at its next check, the positions reached so far are kept
+    void cancel() {
+        if (_control != nullptr)
+            _control->_cancelled = true;
+    }
+
+signals:
+
+    void positionsChanged(const std::vector<GraphType::Node *> &nodes, const std::vector<QPointF> &positions);
+
+    void progressChanged(int percent);
+
+    void finished(bool completed);
+
+private:
+    GraphType::Graph *_graph{};
+    unsigned long _version = 0;
+    std::vector<GraphType::Node *> _nodes;
+    std::shared_ptr<Control> _control;
+    QFuture<void> _future;
+    QTimer _frameTimer;
+
+    bool apply(const std::vector<double> &x, const std::vector<double> &y) {
+        // Node pointers may be stale once nodes were added or removed
+        if (_graph->version() != _version) {
+            cancel();
+            return false;
+        }
+        std::vector<QPointF> positions(_nodes.size());
+        for (size_t i = 0; i < _nodes.size(); ++i)
+            positions[i] = QPointF(x[i], y[i]);
+        emit positionsChanged(_nodes, positions);
+        return true;
+    }
+
+    void showFrame() {
+        if (_control == nullptr || _control->_frameWanted)
+            return;
+        std::vector<double> x, y;
+        {
+            std::lock_guard<std::mutex> lock(_control->_mutex);
+            x.swap(_control->_x);
+            y.swap(_control->_y);
+        }
+        if (apply(x, y))
+            emit progressChanged(_control->_progress);
+        if (_control != nullptr)
+            _control->_frameWanted = true;
+    }
+};
+
+#endif // LAYOUTRUNNER_H
@@ -0,0 +1,120 @@
+#ifndef ADJACENCYHEATMAP_H
+#define ADJACENCYHEATMAP_H
+
+#include "basis/headers/Graph.h"
+#include <QWidget>
+#include <QImage>
+#include <QFutureWatcher>
+#include <QTimer>
+#include <memory>
+#include <vector>
+
+/*
+ * Raster view of the adjacency matrix for graphs too large for a table.
+ * Every pixel aggregates a block of cells; the image is computed on a worker
+ * thread for the visible block range only and re-rendered after zoom/pan.
+ */
+class AdjacencyHeatmap : public QWidget {
+Q_OBJECT
+public:
+    enum Ordering {
+        ByName, ByDegree, ReverseCuthillMcKee
+    };
+
+    enum ColorMode {
+        Density, Weight
+    };
+
+    struct Data {
+        int size = 0;
+        int maxWeight = 1;
+        std::vector<std::string> names;
+        std::vector<int> rowStart;
+        std::vector<int> columns;
+        std::vector<int> weights;
+    };
+
+    struct Range {
+        double x = 0;
+        double y = 0;
+        double span = 0;
+    };
+
+    explicit AdjacencyHeatmap(GraphType::Graph *graph, QWidget *parent = nullptr);
+
+    void setGraph(GraphType::Graph *graph);
+
+    GraphType::Graph *graph() const;
+
+    QSize sizeHint() const override;
+
+public slots:
+
+    void reload();
+
+    void setOrdering(int ordering);
+
+    void setColorMode(int mode);
+
+signals:
+
+    void edgeSelected(std::string uname, std::string vname);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+    void showEvent(QShowEvent *event) override;
+
+    void wheelEvent(QWheelEvent *event) override;
+
+    void mousePressEvent(QMouseEvent *event) override;
+
+    void mouseMoveEvent(QMouseEvent *event) override;
+
+    void mouseReleaseEvent(QMouseEvent *event) override;
+
+    void resizeEvent(QResizeEvent *event) override;
+
+    bool event(QEvent *event) override;
+
+private:
+    GraphType::Graph *_graph{};
+    Ordering _ordering;
+    ColorMode _colorMode;
+    bool _dirty;
+    bool _renderPending;
+    bool _preparePending;
+    bool _panning;
+    QPoint _pressPos;
+    QPoint _lastMousePos;
+    Range _view;
+    Range _imageRange;
+    Range _renderRange;
+    QImage _image;
+    QTimer _renderTimer;
+    std::shared_ptr<const Data> _data;
+    QFutureWatcher<std::shared_ptr<const Data>> _prepareWatcher;
+    QFutureWatcher<QImage> _renderWatcher;
+
+    QRectF canvasRect() const;
+
+    bool cellAt(const QPoint &pos, int &row, int &column) const;
+
+    int cellWeight(int row, int column) const;
+
+    void clampView();
+
+    void startPrepare();
+
+    void startRender();
+
+    void scheduleRender();
+
+    static std::shared_ptr<const Data> prepare(std::vector<std::string> names,
+                                               std::vector<std::pair<int, int>> edges,
+                                               std::vector<int> weights, bool directed, Ordering ordering);
+
+    static QImage render(std::shared_ptr<const Data> data, Range range, int pixels, ColorMode mode);
+};
+
+#endif // ADJACENCYHEATMAP_H
@@ -0,0 +1,61 @@
+#ifndef ADJACENCYMATRIXMODEL_H
+#define ADJACENCYMATRIXMODEL_H
+
+#include "basis/headers/Graph.h"
+#include <QAbstractTableModel>
+#include <vector>
+#include <unordered_map>
+
+/*
+ * Virtual model over the adjacency matrix of a graph.
+ * Only the node order (sorted by name, same as GraphType::Matrix) is cached;
+ * every cell is read from the graph on demand in data().
+ */
+class AdjacencyMatrixModel : public QAbstractTableModel {
+Q_OBJECT
+private:
+    GraphType::Graph *_graph{};
+    std::vector<GraphType::Node *> _nodes;
+    std::unordered_map<const GraphType::Node *, int> _index;
+
+    QString valueText(int row, int column) const;
+
+    QString invalidText() const;
+
+public:
+    explicit AdjacencyMatrixModel(GraphType::Graph *graph, QObject *parent = nullptr);
+
+    void setGraph(GraphType::Graph *graph);
+
+    GraphType::Graph *graph() const;
+
+    GraphType::Node *node(int index) const { return this->_nodes[index]; }
+
+    int indexOf(const GraphType::Node *node) const;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+
+signals:
+
+    void invalidWeight(int row, int column);
+
+public slots:
+
+    void reload();
+
+    void edgeChanged(const std::string &uname, const std::string &vname);
+
+    void applyEvents(const std::vector<GraphType::GraphEvent> &events);
+};
+
+#endif // ADJACENCYMATRIXMODEL_H
@@ -2,15 +2,15 @@
 #define ADJACENCYMATRIXTABLE_H
 
 #include "basis/headers/Graph.h"
-#include <QTableWidget>
+#include "widgets/headers/AdjacencyMatrixModel.h"
+#include <QTableView>
 #include <QHeaderView>
 #include <QKeyEvent>
 
-class AdjacencyMatrixTable : public QTableWidget {
+class AdjacencyMatrixTable : public QTableView {
 Q_OBJECT
 private:
-    GraphType::Graph *_graph{};
-    GraphType::AdjacencyMatrix *_adj{};
+    AdjacencyMatrixModel *_model;
     int _sectionSize;
 
 public:
@@ -22,17 +22,21 @@ public:
 
     GraphType::Graph *graph() const;
 
-signals:
+    AdjacencyMatrixModel *matrixModel() const { return this->_model; }
 
-    void graphChanged();
+signals:
 
     void edgeSelected(std::string uname, std::string vname);
 
 public slots:
 
-    void adjustCell(int row, int column);
+    void showInvalidWeight(int row, int column);
+
+    void edgeChanged(const std::string &uname, const std::string &vname);
 
     void reload();
+
+    void applyEvents(const std::vector<GraphType::GraphEvent> &events);
 };
 
 #endif // ADJACENCYMATRIXTABLE_H
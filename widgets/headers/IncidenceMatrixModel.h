@@ -0,0 +1,47 @@
+#ifndef INCIDENCEMATRIXMODEL_H
+#define INCIDENCEMATRIXMODEL_H
+
+#include "basis/headers/Graph.h"
+#include <QAbstractTableModel>
+#include <vector>
+#include <unordered_map>
+
+/*
+ * Virtual model over the incidence matrix of a graph.
+ * Rows are nodes and columns are edges; a cell is non-zero only for the two
+ * endpoints of its edge, so nothing but the row/column order is stored.
+ */
+class IncidenceMatrixModel : public QAbstractTableModel {
+Q_OBJECT
+private:
+    GraphType::Graph *_graph{};
+    std::vector<GraphType::Node *> _nodes;
+    std::vector<GraphType::NodePair> _edges;
+
+public:
+    explicit IncidenceMatrixModel(GraphType::Graph *graph, QObject *parent = nullptr);
+
+    void setGraph(GraphType::Graph *graph);
+
+    GraphType::Graph *graph() const;
+
+    const GraphType::NodePair &edge(int column) const { return this->_edges[column]; }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+public slots:
+
+    void reload();
+
+    void clear();
+};
+
+#endif // INCIDENCEMATRIXMODEL_H
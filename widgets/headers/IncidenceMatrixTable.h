@@ -2,16 +2,20 @@
 #define INCIDENCEMATRIXTABLE_H
 
 #include "basis/headers/Graph.h"
-#include <QTableWidget>
+#include "widgets/headers/IncidenceMatrixModel.h"
+#include <QTableView>
 #include <QHeaderView>
 #include <QKeyEvent>
 
-class IncidenceMatrixTable : public QTableWidget {
+class IncidenceMatrixTable : public QTableView {
 Q_OBJECT
 private:
-    GraphType::Graph *_graph{};
-    GraphType::IncidenceMatrix *_incidence{};
+    IncidenceMatrixModel *_model;
     int _sectionSize;
+    bool _dirty;
+
+protected:
+    void showEvent(QShowEvent *event) override;
 
 public:
     explicit IncidenceMatrixTable(GraphType::Graph *graph, int sectionSize = 80);
@@ -24,15 +28,11 @@ public:
 
 signals:
 
-    void graphChanged();
-
     void edgeSelected(std::string uname, std::string vname);
 
 public slots:
 
     void reload();
-
-    void adjustCell(int row, int column);
 };
 
 #endif //INCIDENCEMATRIXTABLE_H
@@ -0,0 +1,417 @@
+#include "widgets/headers/AdjacencyHeatmap.h"
+#include <QtConcurrent/QtConcurrent>
+#include <QPainter>
+#include <QWheelEvent>
+#include <QHelpEvent>
+#include <QToolTip>
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <unordered_map>
+
+namespace {
+    const int margin = 8;
+    const double minSpan = 4;
+
+    QRgb lerp(const QColor &from, const QColor &to, double t) {
+        t = std::max(0., std::min(1., t));
+        return qRgb(static_cast<int>(from.red() + (to.red() - from.red()) * t),
+                    static_cast<int>(from.green() + (to.green() - from.green()) * t),
+                    static_cast<int>(from.blue() + (to.blue() - from.blue()) * t));
+    }
+}
+
+AdjacencyHeatmap::AdjacencyHeatmap(GraphType::Graph *graph, QWidget *parent) :
+        QWidget(parent),
+        _graph(graph),
+        _ordering(ByName),
+        _colorMode(Density),
+        _dirty(true),
+        _renderPending(false),
+        _preparePending(false),
+        _panning(false) {
+    setMouseTracking(true);
+    setMinimumSize(256, 256);
+    _renderTimer.setSingleShot(true);
+    _renderTimer.setInterval(30);
+    connect(&_renderTimer, &QTimer::timeout, this, &AdjacencyHeatmap::startRender);
+    connect(&_prepareWatcher, &QFutureWatcher<std::shared_ptr<const Data>>::finished, this, [this]() {
+        auto data = _prepareWatcher.result();
+        if (!_data || _data->size != data->size)
+            _view = Range{0, 0, static_cast<double>(data->size)};
+        this->_data = data;
+        if (_preparePending) {
+            _preparePending = false;
+            startPrepare();
+        }
+        clampView();
+        startRender();
+    });
+    connect(&_renderWatcher, &QFutureWatcher<QImage>::finished, this, [this]() {
+        this->_image = _renderWatcher.result();
+        this->_imageRange = _renderRange;
+        update();
+        if (_renderPending) {
+            _renderPending = false;
+            startRender();
+        }
+    });
+}
+
+void AdjacencyHeatmap::setGraph(GraphType::Graph *graph) {
+    this->_graph = graph;
+    this->_data.reset();
+    this->_image = QImage();
+    reload();
+}
+
+GraphType::Graph *AdjacencyHeatmap::graph() const {
+    return this->_graph;
+}
+
+QSize AdjacencyHeatmap::sizeHint() const {
+    return {900, 900};
+}
+
+void AdjacencyHeatmap::reload() {
+    if (!isVisible()) {
+        this->_dirty = true;
+        return;
+    }
+    this->_dirty = false;
+    startPrepare();
+}
+
+void AdjacencyHeatmap::setOrdering(int ordering) {
+    this->_ordering = static_cast<Ordering>(ordering);
+    reload();
+}
+
+void AdjacencyHeatmap::setColorMode(int mode) {
+    this->_colorMode = static_cast<ColorMode>(mode);
+    scheduleRender();
+}
+
+void AdjacencyHeatmap::startPrepare() {
+    if (_graph == nullptr)
+        return;
+    if (_prepareWatcher.isRunning()) {
+        this->_preparePending = true;
+        return;
+    }
+    // Only the snapshot is taken on the GUI thread, reordering and indexing run in the worker
+    auto node_list = _graph->nodeList();
+    std::vector<GraphType::Node *> nodes(node_list.begin(), node_list.end());
+    std::sort(nodes.begin(), nodes.end(), [](const GraphType::Node *n1, const GraphType::Node *n2) {
+        return n1->name() < n2->name();
+    });
+    std::unordered_map<const GraphType::Node *, int> index;
+    index.reserve(nodes.size());
+    std::vector<std::string> names;
+    names.reserve(nodes.size());
+    for (int i = 0; i < nodes.size(); ++i) {
+        index[nodes[i]] = i;
+        names.push_back(nodes[i]->name());
+    }
+    std::vector<std::pair<int, int>> edges;
+    std::vector<int> weights;
+    edges.reserve(_graph->countEdges());
+    weights.reserve(_graph->countEdges());
+    for (const auto &it: _graph->edgeSet()) {
+        edges.emplace_back(index[it.first.first], index[it.first.second]);
+        weights.push_back(it.second);
+    }
+    _prepareWatcher.setFuture(QtConcurrent::run(&AdjacencyHeatmap::prepare, std::move(names), std::move(edges),
+                                                std::move(weights), _graph->isDirected(), _ordering));
+}
+
+void AdjacencyHeatmap::scheduleRender() {
+    _renderTimer.start();
+}
+
+void AdjacencyHeatmap::startRender() {
+    if (!_data || _data->size == 0) {
+        this->_image = QImage();
+        update();
+        return;
+    }
+    if (_renderWatcher.isRunning()) {
+        this->_renderPending = true;
+        return;
+    }
+    this->_renderRange = _view;
+    int pixels = static_cast<int>(canvasRect().width() * devicePixelRatioF());
+    _renderWatcher.setFuture(QtConcurrent::run(&AdjacencyHeatmap::render, _data, _renderRange,
+                                               std::max(1, pixels), _colorMode));
+}
+
+std::shared_ptr<const AdjacencyHeatmap::Data>
+AdjacencyHeatmap::prepare(std::vector<std::string> names, std::vector<std::pair<int, int>> edges,
+                          std::vector<int> weights, bool directed, Ordering ordering) {
+    auto data = std::make_shared<Data>();
+    int n = static_cast<int>(names.size());
+    data->size = n;
+    if (!directed) {
+        auto count = edges.size();
+        edges.reserve(count * 2);
+        weights.reserve(count * 2);
+        for (int i = 0; i < count; ++i) {
+            edges.emplace_back(edges[i].second, edges[i].first);
+            weights.push_back(weights[i]);
+        }
+    }
+
+    std::vector<int> degree(n, 0);
+    for (const auto &e: edges)
+        degree[e.first]++, degree[e.second]++;
+
+    std::vector<int> order(n);
+    for (int i = 0; i < n; ++i)
+        order[i] = i;
+    if (ordering == ByDegree) {
+        std::stable_sort(order.begin(), order.end(), [&degree](int a, int b) { return degree[a] > degree[b]; });
+    } else if (ordering == ReverseCuthillMcKee) {
+        std::vector<int> start(n + 1, 0), adj(edges.size() * 2);
+        for (const auto &e: edges)
+            start[e.first + 1]++, start[e.second + 1]++;
+        for (int i = 0; i < n; ++i)
+            start[i + 1] += start[i];
+        std::vector<int> fill(start.begin(), start.end() - 1);
+        for (const auto &e: edges) {
+            adj[fill[e.first]++] = e.second;
+            adj[fill[e.second]++] = e.first;
+        }
+        std::vector<int> byDegree(order);
+        std::stable_sort(byDegree.begin(), byDegree.end(), [&degree](int a, int b) { return degree[a] < degree[b]; });
+        std::vector<bool> visited(n, false);
+        std::vector<int> neighbours;
+        order.clear();
+        for (int root: byDegree) {
+            if (visited[root]) continue;
+            std::queue<int> q;
+            q.push(root);
+            visited[root] = true;
+            while (!q.empty()) {
+                int u = q.front();
+                q.pop();
+                order.push_back(u);
+                neighbours.clear();
+                for (int k = start[u]; k < start[u + 1]; ++k)
+                    if (!visited[adj[k]]) {
+                        visited[adj[k]] = true;
+                        neighbours.push_back(adj[k]);
+                    }
+                std::sort(neighbours.begin(), neighbours.end(), [&degree](int a, int b) {
+                    return degree[a] < degree[b];
+                });
+                for (int v: neighbours)
+                    q.push(v);
+            }
+        }
+        std::reverse(order.begin(), order.end());
+    }
+
+    std::vector<int> position(n);
+    data->names.resize(n);
+    for (int i = 0; i < n; ++i) {
+        position[order[i]] = i;
+        data->names[i] = std::move(names[order[i]]);
+    }
+
+    data->rowStart.assign(n + 1, 0);
+    for (const auto &e: edges)
+        data->rowStart[position[e.first] + 1]++;
+    for (int i = 0; i < n; ++i)
+        data->rowStart[i + 1] += data->rowStart[i];
+    std::vector<std::pair<int, int>> cells(edges.size());
+    std::vector<int> fill(data->rowStart.begin(), data->rowStart.end() - 1);
+    for (int i = 0; i < edges.size(); ++i)
+        cells[fill[position[edges[i].first]]++] = {position[edges[i].second], weights[i]};
+    for (int r = 0; r < n; ++r)
+        std::sort(cells.begin() + data->rowStart[r], cells.begin() + data->rowStart[r + 1]);
+    data->columns.resize(cells.size());
+    data->weights.resize(cells.size());
+    for (int i = 0; i < cells.size(); ++i) {
+        data->columns[i] = cells[i].first;
+        data->weights[i] = cells[i].second;
+        data->maxWeight = std::max(data->maxWeight, cells[i].second);
+    }
+    return data;
+}
+
+QImage AdjacencyHeatmap::render(std::shared_ptr<const Data> data, Range range, int pixels, ColorMode mode) {
+    int n = data->size;
+    int dim = std::max(1, std::min(pixels, static_cast<int>(std::ceil(range.span))));
+    double scale = dim / range.span;
+    std::vector<int> counts(dim * dim, 0);
+    std::vector<double> sums(dim * dim, 0);
+
+    int r0 = std::max(0, static_cast<int>(std::floor(range.y)));
+    int r1 = std::min(n, static_cast<int>(std::ceil(range.y + range.span)));
+    int c0 = std::max(0, static_cast<int>(std::floor(range.x)));
+    int c1 = std::min(n, static_cast<int>(std::ceil(range.x + range.span)));
+    for (int r = r0; r < r1; ++r) {
+        int py = std::min(dim - 1, std::max(0, static_cast<int>((r - range.y) * scale)));
+        auto begin = data->columns.begin() + data->rowStart[r];
+        auto end = data->columns.begin() + data->rowStart[r + 1];
+        for (auto it = std::lower_bound(begin, end, c0); it != end && *it < c1; ++it) {
+            int px = std::min(dim - 1, std::max(0, static_cast<int>((*it - range.x) * scale)));
+            counts[py * dim + px]++;
+            sums[py * dim + px] += data->weights[it - data->columns.begin()];
+        }
+    }
+
+    int maxCount = std::max(1, *std::max_element(counts.begin(), counts.end()));
+    const QColor outside(230, 230, 230), empty(Qt::white);
+    const QColor densityColor(57, 89, 119), lightWeight(255, 237, 160), heavyWeight(189, 0, 38);
+    QImage image(dim, dim, QImage::Format_RGB32);
+    for (int py = 0; py < dim; ++py) {
+        auto line = reinterpret_cast<QRgb *>(image.scanLine(py));
+        double row = range.y + (py + .5) / scale;
+        for (int px = 0; px < dim; ++px) {
+            double column = range.x + (px + .5) / scale;
+            int count = counts[py * dim + px];
+            if (row < 0 || row >= n || column < 0 || column >= n)
+                line[px] = outside.rgb();
+            else if (count == 0)
+                line[px] = empty.rgb();
+            else if (mode == Density)
+                line[px] = lerp(empty, densityColor, .15 + .85 * std::sqrt(double(count) / maxCount));
+            else
+                line[px] = lerp(lightWeight, heavyWeight, sums[py * dim + px] / count / data->maxWeight);
+        }
+    }
+    return image;
+}
+
+QRectF AdjacencyHeatmap::canvasRect() const {
+    qreal side = std::max(1, std::min(width(), height()) - 2 * margin);
+    return {(width() - side) / 2, (height() - side) / 2, side, side};
+}
+
+void AdjacencyHeatmap::clampView() {
+    if (!_data || _data->size == 0) {
+        _view = Range();
+        return;
+    }
+    double n = _data->size;
+    _view.span = std::max(std::min(n, minSpan), std::min(n, _view.span));
+    _view.x = std::max(0., std::min(n - _view.span, _view.x));
+    _view.y = std::max(0., std::min(n - _view.span, _view.y));
+}
+
+bool AdjacencyHeatmap::cellAt(const QPoint &pos, int &row, int &column) const {
+    auto rect = canvasRect();
+    if (!_data || _data->size == 0 || !rect.contains(pos))
+        return false;
+    column = static_cast<int>(std::floor(_view.x + (pos.x() - rect.x()) / rect.width() * _view.span));
+    row = static_cast<int>(std::floor(_view.y + (pos.y() - rect.y()) / rect.height() * _view.span));
+    return row >= 0 && row < _data->size && column >= 0 && column < _data->size;
+}
+
+int AdjacencyHeatmap::cellWeight(int row, int column) const {
+    auto begin = _data->columns.begin() + _data->rowStart[row];
+    auto end = _data->columns.begin() + _data->rowStart[row + 1];
+    auto it = std::lower_bound(begin, end, column);
+    if (it == end || *it != column)
+        return 0;
+    return _data->weights[it - _data->columns.begin()];
+}
+
+void AdjacencyHeatmap::paintEvent(QPaintEvent *event) {
+    Q_UNUSED(event);
+    QPainter painter(this);
+    auto rect = canvasRect();
+    painter.fillRect(rect, QColor(230, 230, 230));
+    if (!_image.isNull() && _imageRange.span > 0 && _view.span > 0) {
+        // The last image is stretched to the current view until the worker delivers a fresh one
+        double k = rect.width() / _view.span;
+        QRectF target(rect.x() + (_imageRange.x - _view.x) * k,
+                      rect.y() + (_imageRange.y - _view.y) * k,
+                      _imageRange.span * k, _imageRange.span * k);
+        painter.save();
+        painter.setClipRect(rect);
+        painter.drawImage(target, _image);
+        painter.restore();
+    }
+    painter.setPen(QPen(Qt::darkGray, 1));
+    painter.drawRect(rect);
+}
+
+void AdjacencyHeatmap::showEvent(QShowEvent *event) {
+    QWidget::showEvent(event);
+    if (_dirty)
+        reload();
+}
+
+void AdjacencyHeatmap::resizeEvent(QResizeEvent *event) {
+    QWidget::resizeEvent(event);
+    scheduleRender();
+}
+
+void AdjacencyHeatmap::wheelEvent(QWheelEvent *event) {
+    if (!_data || _data->size == 0)
+        return;
+    auto rect = canvasRect();
+    double fx = (event->pos().x() - rect.x()) / rect.width();
+    double fy = (event->pos().y() - rect.y()) / rect.height();
+    double cx = _view.x + fx * _view.span;
+    double cy = _view.y + fy * _view.span;
+    _view.span *= event->delta() > 0 ? 0.8 : 1.25;
+    clampView();
+    _view.x = cx - fx * _view.span;
+    _view.y = cy - fy * _view.span;
+    clampView();
+    update();
+    scheduleRender();
+}
+
+void AdjacencyHeatmap::mousePressEvent(QMouseEvent *event) {
+    if (event->button() == Qt::LeftButton) {
+        this->_panning = true;
+        this->_pressPos = this->_lastMousePos = event->pos();
+        setCursor(Qt::ClosedHandCursor);
+    }
+    QWidget::mousePressEvent(event);
+}
+
+void AdjacencyHeatmap::mouseMoveEvent(QMouseEvent *event) {
+    if (_panning && _data) {
+        double k = _view.span / canvasRect().width();
+        _view.x -= (event->pos().x() - _lastMousePos.x()) * k;
+        _view.y -= (event->pos().y() - _lastMousePos.y()) * k;
+        _lastMousePos = event->pos();
+        clampView();
+        update();
+        scheduleRender();
+    }
+    QWidget::mouseMoveEvent(event);
+}
+
+void AdjacencyHeatmap::mouseReleaseEvent(QMouseEvent *event) {
+    if (event->button() == Qt::LeftButton && _panning) {
+        this->_panning = false;
+        unsetCursor();
+        int row, column;
+        if ((event->pos() - _pressPos).manhattanLength() < 3 && cellAt(event->pos(), row, column)
+            && cellWeight(row, column) != 0)
+            emit edgeSelected(_data->names[row], _data->names[column]);
+    }
+    QWidget::mouseReleaseEvent(event);
+}
+
+bool AdjacencyHeatmap::event(QEvent *event) {
+    if (event->type() == QEvent::ToolTip) {
+        auto helpEvent = static_cast<QHelpEvent *>(event);
+        int row, column;
+        if (cellAt(helpEvent->pos(), row, column)) {
+            auto text = QString::fromStdString(_data->names[row] + " -> " + _data->names[column]);
+            int w = cellWeight(row, column);
+            text += w != 0 ? ": " + QString::number(w) : QString(": нет ребра");
+            QToolTip::showText(helpEvent->globalPos(), text, this);
+        } else
+            QToolTip::hideText();
+        return true;
+    }
+    return QWidget::event(event);
+}
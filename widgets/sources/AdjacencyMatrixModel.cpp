@@ -0,0 +1,146 @@
+#include "widgets/headers/AdjacencyMatrixModel.h"
+#include <QRegExp>
+#include <algorithm>
+
+AdjacencyMatrixModel::AdjacencyMatrixModel(GraphType::Graph *graph, QObject *parent) : QAbstractTableModel(parent) {
+    setGraph(graph);
+}
+
+void AdjacencyMatrixModel::setGraph(GraphType::Graph *graph) {
+    this->_graph = graph;
+    reload();
+}
+
+GraphType::Graph *AdjacencyMatrixModel::graph() const {
+    return this->_graph;
+}
+
+void AdjacencyMatrixModel::reload() {
+    beginResetModel();
+    this->_nodes.clear();
+    this->_index.clear();
+    if (_graph != nullptr) {
+        auto node_list = _graph->nodeList();
+        this->_nodes.assign(node_list.begin(), node_list.end());
+        std::sort(_nodes.begin(), _nodes.end(), [](const GraphType::Node *n1, const GraphType::Node *n2) {
+            return n1->name() < n2->name();
+        });
+        this->_index.reserve(_nodes.size());
+        for (int i = 0; i < _nodes.size(); ++i)
+            this->_index[_nodes[i]] = i;
+    }
+    endResetModel();
+}
+
+int AdjacencyMatrixModel::indexOf(const GraphType::Node *node) const {
+    auto it = _index.find(node);
+    return it != _index.end() ? it->second : -1;
+}
+
+void AdjacencyMatrixModel::edgeChanged(const std::string &uname, const std::string &vname) {
+    int row = indexOf(_graph->node(uname));
+    int column = indexOf(_graph->node(vname));
+    if (row < 0 || column < 0) return;
+    emit dataChanged(index(row, column), index(row, column));
+    if (_graph->isUndirected())
+        emit dataChanged(index(column, row), index(column, row));
+}
+
+void AdjacencyMatrixModel::applyEvents(const std::vector<GraphType::GraphEvent> &events) {
+    for (const auto &event: events)
+        if (event.type != GraphType::GraphEvent::EdgeSet && event.type != GraphType::GraphEvent::EdgeRemoved) {
+            // The node order changed, cached rows are no longer valid
+            reload();
+            return;
+        }
+    for (const auto &event: events)
+        edgeChanged(event.u, event.v);
+}
+
+int AdjacencyMatrixModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(_nodes.size());
+}
+
+int AdjacencyMatrixModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(_nodes.size());
+}
+
+QString AdjacencyMatrixModel::invalidText() const {
+    return _graph->invalidValue() == INT_MAX ? "inf" : QString::number(_graph->invalidValue());
+}
+
+QString AdjacencyMatrixModel::valueText(int row, int column) const {
+    auto u = _nodes[row], v = _nodes[column];
+    if (u == v || !_graph->hasEdge(u, v))
+        return invalidText();
+    return QString::number(_graph->weight(u, v));
+}
+
+QVariant AdjacencyMatrixModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || _graph == nullptr)
+        return QVariant();
+    int row = index.row(), column = index.column();
+    switch (role) {
+        case Qt::DisplayRole:
+        case Qt::EditRole:
+            return valueText(row, column);
+        case Qt::TextAlignmentRole:
+            return int(Qt::AlignCenter);
+        case Qt::ToolTipRole: {
+            if (row == column) return QVariant();
+            auto u = QString::fromStdString(_nodes[row]->name());
+            auto v = QString::fromStdString(_nodes[column]->name());
+            if (_graph->hasEdge(_nodes[row], _nodes[column]))
+                return "Weight of the edge from node " + u + " to node " + v;
+            return "No edge from node " + u + " to node " + v;
+        }
+        default:
+            return QVariant();
+    }
+}
+
+QVariant AdjacencyMatrixModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    Q_UNUSED(orientation);
+    if (role != Qt::DisplayRole || section < 0 || section >= _nodes.size())
+        return QVariant();
+    return QString::fromStdString(_nodes[section]->name());
+}
+
+Qt::ItemFlags AdjacencyMatrixModel::flags(const QModelIndex &index) const {
+    if (!index.isValid())
+        return Qt::NoItemFlags;
+    if (index.row() == index.column() || (_graph->isUndirected() && index.column() < index.row()))
+        return Qt::ItemIsEditable;
+    return Qt::ItemIsSelectable | Qt::ItemIsEditable | Qt::ItemIsEnabled;
+}
+
+bool AdjacencyMatrixModel::setData(const QModelIndex &index, const QVariant &value, int role) {
+    if (!index.isValid() || role != Qt::EditRole)
+        return false;
+    int row = index.row(), column = index.column();
+    QRegExp re("\\d*");
+    QString data = value.toString().trimmed();
+    if (data.isEmpty())
+        data = invalidText();
+    if (data == valueText(row, column))
+        return false;
+
+    bool is_invalid_value = data == invalidText();
+    bool out_of_range = false;
+    if (re.exactMatch(data))
+        out_of_range = (data.toLongLong() < _graph->weightRange().first ||
+                        data.toLongLong() > _graph->weightRange().second);
+    else if (!is_invalid_value)
+        out_of_range = true;
+
+    if (out_of_range && !is_invalid_value) {
+        emit invalidWeight(row, column);
+        return false;
+    }
+    if (is_invalid_value)
+        _graph->removeEdge(_nodes[row], _nodes[column]);
+    else
+        _graph->setEdge(_nodes[row], _nodes[column], data.toInt());
+    edgeChanged(_nodes[row]->name(), _nodes[column]->name());
+    return true;
+}
@@ -14,6 +14,7 @@ ElementPropertiesTable::ElementPropertiesTable(GraphType::Graph *graph) : Elemen
 
 void ElementPropertiesTable::setGraph(GraphType::Graph *graph) {
     this->_graph = graph;
+    clearTable();
 }
 
 void ElementPropertiesTable::clearTable() {
@@ -0,0 +1,87 @@
+#include "widgets/headers/IncidenceMatrixModel.h"
+#include <algorithm>
+
+IncidenceMatrixModel::IncidenceMatrixModel(GraphType::Graph *graph, QObject *parent) : QAbstractTableModel(parent) {
+    this->_graph = graph;
+}
+
+void IncidenceMatrixModel::setGraph(GraphType::Graph *graph) {
+    this->_graph = graph;
+    clear();
+}
+
+GraphType::Graph *IncidenceMatrixModel::graph() const {
+    return this->_graph;
+}
+
+void IncidenceMatrixModel::clear() {
+    beginResetModel();
+    this->_nodes = std::vector<GraphType::Node *>();
+    this->_edges = std::vector<GraphType::NodePair>();
+    endResetModel();
+}
+
+void IncidenceMatrixModel::reload() {
+    beginResetModel();
+    this->_nodes.clear();
+    this->_edges.clear();
+    if (_graph != nullptr) {
+        auto node_list = _graph->nodeList();
+        this->_nodes.assign(node_list.begin(), node_list.end());
+        std::sort(_nodes.begin(), _nodes.end(), [](const GraphType::Node *n1, const GraphType::Node *n2) {
+            return n1->name() < n2->name();
+        });
+        this->_edges.reserve(_graph->countEdges());
+        for (const auto &it: _graph->edgeSet())
+            this->_edges.push_back(it.first);
+        std::sort(_edges.begin(), _edges.end(), [](const GraphType::NodePair &e1, const GraphType::NodePair &e2) {
+            int cmp = e1.first->name().compare(e2.first->name());
+            return cmp != 0 ? cmp < 0 : e1.second->name() < e2.second->name();
+        });
+    }
+    endResetModel();
+}
+
+int IncidenceMatrixModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(_nodes.size());
+}
+
+int IncidenceMatrixModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(_edges.size());
+}
+
+QVariant IncidenceMatrixModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid())
+        return QVariant();
+    if (role == Qt::TextAlignmentRole)
+        return int(Qt::AlignCenter);
+    if (role != Qt::DisplayRole)
+        return QVariant();
+
+    auto node = _nodes[index.row()];
+    const auto &edge = _edges[index.column()];
+    if (node != edge.first && node != edge.second)
+        return 0;
+    auto it = _graph->edgeSet().find(edge);
+    int weight = it != _graph->edgeSet().end() ? it->second : 0;
+    if (node == edge.first)
+        return weight;
+    return (_graph->isDirected() ? -1 : 1) * weight;
+}
+
+QVariant IncidenceMatrixModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (role != Qt::DisplayRole || section < 0)
+        return QVariant();
+    if (orientation == Qt::Horizontal) {
+        if (section >= _edges.size()) return QVariant();
+        return QString::fromStdString(_edges[section].first->name() + "-" + _edges[section].second->name());
+    }
+    if (section >= _nodes.size()) return QVariant();
+    return QString::fromStdString(_nodes[section]->name());
+}
+
+Qt::ItemFlags IncidenceMatrixModel::flags(const QModelIndex &index) const {
+    if (!index.isValid())
+        return Qt::NoItemFlags;
+    return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+}